@@ -0,0 +1,503 @@
+/*
+Benchmark driver for all three engines:
+- Q1: naiveSearch / KMPsearch / rabinKarpSearch (timed through their *Scan cores),
+  plus the approximate shiftAndSearch / myersSearch with --k errors
+- Q2: longestCommonSubstring
+- Q3: Aho build (insert_pattern + build_links) and scan
+- Teddy: the SIMD multi-literal engine on the same pattern set as Aho; the
+  set is sampled from printable windows, so only the random corpus (where
+  none exist) gives a "skipped": true result
+Corpora are generated from a fixed seed so two runs with the same arguments
+see byte-identical input. Results are printed as one JSON document.
+
+Build:
+    g++ -O2 -std=c++17 Bench_23I-0782.cpp -o output/Bench_23I-0782
+
+Usage:
+    Bench_23I-0782 [--sizes 1K,64K,1M,16M] [--corpora random,dna,periodic,english]
+                   [--engines naive,kmp,rabin-karp,shift-and,myers,aho,teddy,lcs] [--seed 42]
+                   [--reps 3] [--pattern-len 16] [--k 2] [--aho-patterns 32] [--lcs-max 64K] [--out file.json]
+Sizes take K/M/G suffixes (powers of 1024). Engines use int indices, so a
+corpus must stay below 2G.
+Building with -DSTRMATCH_STATS adds a "stats" object (summed over all reps)
+to every result; leave it off for throughput numbers.
+*/
+
+// platform headers first: <windows.h> must precede the Q files' "using namespace std"
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#define STRMATCH_NO_MAIN
+#include "Q1_23I-0782.cpp"
+#include "Q2_23I-0782.cpp"
+#include "Q3_23I-0782.cpp"
+#include "Teddy_23I-0782.h"
+
+// -----------------------------
+// Deterministic random source
+// -----------------------------
+// mt19937_64's output sequence is fixed by the standard, the <random>
+// distributions are not, so all sampling is done on raw 64-bit words.
+struct Rng {
+    mt19937_64 eng;
+    explicit Rng(uint64_t seed) : eng(seed) {}
+    uint64_t next() { return eng(); }
+    uint64_t below(uint64_t bound) { return next() % bound; }
+    double unit() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+static uint64_t mixSeed(uint64_t seed, const string &tag, uint64_t size) {
+    uint64_t h = seed ^ 0x9E3779B97F4A7C15ULL;
+    for (char c : tag) h = (h ^ (unsigned char)c) * 0x100000001B3ULL;
+    return h ^ (size * 0xBF58476D1CE4E5B9ULL);
+}
+
+// -----------------------------
+// Corpus generators
+// -----------------------------
+// random: uniform bytes 0..255
+string genRandom(size_t n, Rng &rng) {
+    string s(n, '\0');
+    size_t i = 0;
+    while (i < n) {
+        uint64_t w = rng.next();
+        for (int b = 0; b < 8 && i < n; ++b, w >>= 8) s[i++] = (char)(w & 0xFF);
+    }
+    return s;
+}
+
+// dna: uniform over {A,C,G,T}
+string genDNA(size_t n, Rng &rng) {
+    static const char BASES[4] = {'A', 'C', 'G', 'T'};
+    string s(n, '\0');
+    size_t i = 0;
+    while (i < n) {
+        uint64_t w = rng.next();
+        for (int b = 0; b < 32 && i < n; ++b, w >>= 2) s[i++] = BASES[w & 3];
+    }
+    return s;
+}
+
+// periodic: a short random unit (length 2..6) repeated, with a point
+// mutation roughly every 1K bytes so the text is not trivially constant
+string genPeriodic(size_t n, Rng &rng) {
+    int unitLen = 2 + (int)rng.below(5);
+    string unit;
+    for (int i = 0; i < unitLen; ++i) unit.push_back(char('a' + rng.below(4)));
+    string s(n, '\0');
+    for (size_t i = 0; i < n; ++i) s[i] = unit[i % unitLen];
+    for (size_t i = rng.below(2048); i < n; i += 1 + rng.below(2048))
+        s[i] = char('a' + rng.below(26));
+    return s;
+}
+
+// english: words drawn from a small vocabulary with Zipf (1/rank) weights,
+// sentence-cased, with punctuation and paragraph breaks
+string genEnglish(size_t n, Rng &rng) {
+    static const char *WORDS[] = {
+        "the", "of", "and", "to", "a", "in", "is", "that", "for", "it",
+        "was", "on", "with", "as", "his", "they", "at", "be", "this", "from",
+        "had", "by", "not", "but", "what", "all", "were", "when", "we", "there",
+        "can", "an", "your", "which", "their", "said", "each", "she", "do", "how",
+        "city", "river", "ancient", "scholars", "travelers", "merchants", "stone", "gates",
+        "wisdom", "mountains", "silver", "morning", "library", "through", "quiet", "streets",
+        "centuries", "narrow", "market", "light", "between", "water", "bridge", "story"};
+    const int W = sizeof(WORDS) / sizeof(WORDS[0]);
+    vector<double> cdf(W);
+    double total = 0;
+    for (int i = 0; i < W; ++i) cdf[i] = (total += 1.0 / (i + 1));
+    for (double &c : cdf) c /= total;
+
+    string s;
+    s.reserve(n + 32);
+    while (s.size() < n) {
+        int words = 5 + (int)rng.below(16);
+        for (int w = 0; w < words; ++w) {
+            int id = (int)(lower_bound(cdf.begin(), cdf.end(), rng.unit()) - cdf.begin());
+            if (id >= W) id = W - 1;
+            size_t start = s.size();
+            s += WORDS[id];
+            if (w == 0) s[start] = char(toupper((unsigned char)s[start]));
+            if (w + 1 < words) s += (rng.below(12) == 0) ? ", " : " ";
+        }
+        s += '.';
+        s += (rng.below(6) == 0) ? "\n\n" : " ";
+    }
+    s.resize(n);
+    return s;
+}
+
+string genCorpus(const string &kind, size_t n, Rng &rng) {
+    if (kind == "random") return genRandom(n, rng);
+    if (kind == "dna") return genDNA(n, rng);
+    if (kind == "periodic") return genPeriodic(n, rng);
+    if (kind == "english") return genEnglish(n, rng);
+    return "";
+}
+
+// -----------------------------
+// Peak RSS
+// -----------------------------
+// On Linux the high-water mark can be reset per case through clear_refs,
+// elsewhere only the process-wide peak is available.
+bool resetPeakRss() {
+#ifdef __linux__
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (!f) return false;
+    bool ok = fputs("5", f) >= 0;
+    return fclose(f) == 0 && ok;
+#else
+    return false;
+#endif
+}
+
+long long peakRssKB() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return (long long)(pmc.PeakWorkingSetSize / 1024);
+    return -1;
+#elif defined(__linux__)
+    ifstream st("/proc/self/status");
+    string line;
+    while (getline(st, line))
+        if (line.compare(0, 6, "VmHWM:") == 0) return atoll(line.c_str() + 6);
+    return -1;
+#else
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+#ifdef __APPLE__
+    return ru.ru_maxrss / 1024; // bytes on macOS
+#else
+    return ru.ru_maxrss;
+#endif
+#endif
+}
+
+// -----------------------------
+// Timing helpers
+// -----------------------------
+using Clock = chrono::steady_clock;
+
+static double msSince(Clock::time_point t0) {
+    return chrono::duration<double, milli>(Clock::now() - t0).count();
+}
+
+static double median(vector<double> v) {
+    sort(v.begin(), v.end());
+    size_t k = v.size() / 2;
+    return v.size() % 2 ? v[k] : (v[k - 1] + v[k]) / 2;
+}
+
+struct Result {
+    string corpus, engine;
+    size_t size = 0;
+    int patternLen = 0, patterns = 0;
+    long long matches = 0;
+    double buildMs = 0, scanMs = 0, scanMinMs = 0;
+    long long peakKB = -1;
+    bool rssPerCase = false;
+    long long extra = -1; // aho: trie states, lcs: result length, teddy: Teddy::selective()
+    bool skipped = false; // teddy: dictionary not eligible
+    MatchStats stats;
+};
+
+struct Config {
+    vector<size_t> sizes = {1 << 10, 64 << 10, 1 << 20, 16 << 20};
+    vector<string> corpora = {"random", "dna", "periodic", "english"};
+    vector<string> engines = {"naive", "kmp", "rabin-karp", "shift-and", "myers", "aho", "teddy", "lcs"};
+    uint64_t seed = 42;
+    int reps = 3;
+    int patternLen = 16;
+    int k = 2;                   // allowed errors for shift-and / myers
+    int ahoPatterns = 32;
+    size_t lcsMax = 64 << 10;
+    string out;
+};
+
+// Runs fn() cfg.reps times and fills scanMs (median) / scanMinMs.
+template <typename Fn>
+void timeReps(const Config &cfg, Result &r, Fn fn) {
+    vector<double> t;
+    for (int rep = 0; rep < cfg.reps; ++rep) {
+        auto t0 = Clock::now();
+        r.matches = fn();
+        t.push_back(msSince(t0));
+    }
+    r.scanMs = median(t);
+    r.scanMinMs = *min_element(t.begin(), t.end());
+}
+
+string samplePattern(const string &text, int len, Rng &rng) {
+    if ((int)text.size() <= len) return text;
+    return text.substr(rng.below(text.size() - len), len);
+}
+
+Result runSingle(const Config &cfg, const string &engine, const string &corpus,
+                 const string &text, Rng &rng) {
+    Result r;
+    r.corpus = corpus; r.engine = engine; r.size = text.size();
+    string pattern = samplePattern(text, cfg.patternLen, rng);
+    r.patternLen = (int)pattern.size(); r.patterns = 1;
+    r.rssPerCase = resetPeakRss();
+    resetStats();
+
+    if (engine == "naive") {
+        timeReps(cfg, r, [&] { long long c = 0; naiveScan(text, pattern, [&](int) { ++c; }); return c; });
+    } else if (engine == "kmp") {
+        timeReps(cfg, r, [&] { long long c = 0; KMPscan(text, pattern, [&](int) { ++c; }); return c; });
+    } else if (engine == "rabin-karp") {
+        timeReps(cfg, r, [&] { long long c = 0; rabinKarpScan(text, pattern, [&](int) { ++c; }); return c; });
+    } else if (engine == "shift-and") {
+        timeReps(cfg, r, [&] { long long c = 0; shiftAndScan(text, pattern, cfg.k, [&](int, int) { ++c; }); return c; });
+    } else if (engine == "myers") {
+        timeReps(cfg, r, [&] { long long c = 0; myersScan(text, pattern, cfg.k, [&](int, int) { ++c; }); return c; });
+    }
+    r.peakKB = peakRssKB();
+    r.stats = g_stats;
+    return r;
+}
+
+// Teddy only takes printable literals, so dictionary windows are drawn until
+// one has no control bytes (english paragraph breaks, random bytes); after
+// 64 tries the last window is kept and Teddy reports the case as skipped.
+string samplePrintable(const string &text, int len, Rng &rng) {
+    string p;
+    for (int attempt = 0; attempt < 64; ++attempt) {
+        p = samplePattern(text, len, rng);
+        bool printable = true;
+        for (char ch : p)
+            if (ch < 32 || ch > 126) printable = false;
+        if (printable) break;
+    }
+    return p;
+}
+
+vector<string> sampleDictionary(const Config &cfg, const string &text, Rng &rng) {
+    vector<string> patterns;
+    for (int i = 0; i < cfg.ahoPatterns; ++i) {
+        string p = samplePrintable(text, cfg.patternLen, rng);
+        for (char &ch : p) ch = norm_char(ch);
+        patterns.push_back(p);
+    }
+    return patterns;
+}
+
+Result runAho(const Config &cfg, const string &corpus, const string &text, Rng &rng) {
+    Result r;
+    r.corpus = corpus; r.engine = "aho"; r.size = text.size();
+    r.patternLen = cfg.patternLen; r.patterns = cfg.ahoPatterns;
+    vector<string> patterns = sampleDictionary(cfg, text, rng);
+    r.rssPerCase = resetPeakRss();
+    resetStats();
+
+    vector<double> build;
+    Aho aho;
+    for (int rep = 0; rep < cfg.reps; ++rep) {
+        auto t0 = Clock::now();
+        aho = Aho();
+        for (int i = 0; i < (int)patterns.size(); ++i) aho.insert_pattern(patterns[i], i);
+        aho.build_links();
+        build.push_back(msSince(t0));
+    }
+    r.buildMs = median(build);
+    r.extra = (long long)aho.trie.size();
+    timeReps(cfg, r, [&] { long long c = 0; aho.scan(text, [&](int, int) { ++c; }); return c; });
+    r.peakKB = peakRssKB();
+    r.stats = g_stats;
+    return r;
+}
+
+// r.skipped is set when the dictionary is not one Teddy accepts
+Result runTeddy(const Config &cfg, const string &corpus, const string &text, Rng &rng) {
+    Result r;
+    r.corpus = corpus; r.engine = "teddy"; r.size = text.size();
+    r.patternLen = cfg.patternLen; r.patterns = cfg.ahoPatterns;
+    vector<string> patterns = sampleDictionary(cfg, text, rng);
+    if (!Teddy::eligible(patterns)) { r.skipped = true; return r; }
+    r.rssPerCase = resetPeakRss();
+    resetStats();
+
+    vector<double> build;
+    Teddy teddy;
+    for (int rep = 0; rep < cfg.reps; ++rep) {
+        auto t0 = Clock::now();
+        teddy.build(patterns);
+        build.push_back(msSince(t0));
+    }
+    r.buildMs = median(build);
+    teddy.calibrate(string_view(text).substr(0, 1 << 16));  // as Scan_23I-0782 does
+    r.extra = teddy.selective();
+    timeReps(cfg, r, [&] { long long c = 0; teddy.scan(text, [&](int, int) { ++c; }); return c; });
+    r.peakKB = peakRssKB();
+    r.stats = g_stats;
+    return r;
+}
+
+Result runLCS(const Config &cfg, const string &corpus, const string &A, const string &B) {
+    Result r;
+    r.corpus = corpus; r.engine = "lcs"; r.size = A.size() + B.size();
+    r.rssPerCase = resetPeakRss();
+    resetStats();
+    timeReps(cfg, r, [&] { return (long long)longestCommonSubstring(A, B).size(); });
+    r.extra = r.matches;
+    r.matches = 0;
+    r.peakKB = peakRssKB();
+    r.stats = g_stats;
+    return r;
+}
+
+// -----------------------------
+// Output
+// -----------------------------
+void writeJSON(ostream &os, const Config &cfg, const vector<Result> &results) {
+    os << fixed << setprecision(3);
+    os << "{\n  \"schema\": \"strmatch-bench/1\",\n";
+    os << "  \"config\": {\"seed\": " << cfg.seed << ", \"reps\": " << cfg.reps
+       << ", \"pattern_len\": " << cfg.patternLen << ", \"k\": " << cfg.k << ", \"aho_patterns\": " << cfg.ahoPatterns
+       << ", \"lcs_max\": " << cfg.lcsMax << "},\n";
+#ifdef __VERSION__
+    os << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+#endif
+    os << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result &r = results[i];
+        double mbps = r.scanMs > 0 ? (r.size / 1048576.0) / (r.scanMs / 1000.0) : 0;
+        os << "    {\"engine\": \"" << r.engine << "\", \"corpus\": \"" << r.corpus
+           << "\", \"bytes\": " << r.size;
+        if (r.skipped) {
+            os << ", \"patterns\": " << r.patterns << ", \"skipped\": true}"
+               << (i + 1 < results.size() ? "," : "") << "\n";
+            continue;
+        }
+        if (r.engine != "lcs")
+            os << ", \"pattern_len\": " << r.patternLen << ", \"patterns\": " << r.patterns
+               << ", \"matches\": " << r.matches;
+        if (r.engine == "aho") os << ", \"build_ms\": " << r.buildMs << ", \"states\": " << r.extra;
+        if (r.engine == "teddy")
+            os << ", \"build_ms\": " << r.buildMs << ", \"selective\": " << (r.extra ? "true" : "false");
+        if (r.engine == "lcs") os << ", \"lcs_len\": " << r.extra;
+        os << ", \"time_ms\": " << r.scanMs << ", \"time_min_ms\": " << r.scanMinMs
+           << ", \"mb_per_s\": " << mbps << ", \"peak_rss_kb\": " << r.peakKB
+           << ", \"rss_scope\": \"" << (r.rssPerCase ? "case" : "process") << "\"";
+        if (STATS_ENABLED) {
+            os << ", \"stats\": ";
+            printStatsJSON(os, r.stats);
+        }
+        os << "}"
+           << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+}
+
+// -----------------------------
+// Argument parsing
+// -----------------------------
+static vector<string> splitList(const string &s) {
+    vector<string> out;
+    stringstream ss(s);
+    string item;
+    while (getline(ss, item, ','))
+        if (!item.empty()) out.push_back(item);
+    return out;
+}
+
+// "64K" -> 65536; returns 0 on malformed input
+static size_t parseSize(const string &s) {
+    char *end = nullptr;
+    unsigned long long v = strtoull(s.c_str(), &end, 10);
+    if (end == s.c_str()) return 0;
+    switch (toupper((unsigned char)*end)) {
+        case 'K': v <<= 10; ++end; break;
+        case 'M': v <<= 20; ++end; break;
+        case 'G': v <<= 30; ++end; break;
+        default: break;
+    }
+    if (*end == 'B' || *end == 'b') ++end;
+    return *end ? 0 : (size_t)v;
+}
+
+static bool parseArgs(int argc, char **argv, Config &cfg) {
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        if (i + 1 >= argc) { cerr << "Missing value for " << a << "\n"; return false; }
+        string v = argv[++i];
+        if (a == "--sizes") {
+            cfg.sizes.clear();
+            for (auto &s : splitList(v)) {
+                size_t n = parseSize(s);
+                if (n == 0 || n >= (size_t)INT_MAX) { cerr << "Bad size '" << s << "' (must be 1..2G-1)\n"; return false; }
+                cfg.sizes.push_back(n);
+            }
+        } else if (a == "--corpora") cfg.corpora = splitList(v);
+        else if (a == "--engines") cfg.engines = splitList(v);
+        else if (a == "--seed") cfg.seed = strtoull(v.c_str(), nullptr, 10);
+        else if (a == "--reps") cfg.reps = max(1, atoi(v.c_str()));
+        else if (a == "--pattern-len") cfg.patternLen = max(1, atoi(v.c_str()));
+        else if (a == "--k") cfg.k = max(0, atoi(v.c_str()));
+        else if (a == "--aho-patterns") cfg.ahoPatterns = max(1, atoi(v.c_str()));
+        else if (a == "--lcs-max") cfg.lcsMax = parseSize(v);
+        else if (a == "--out") cfg.out = v;
+        else { cerr << "Unknown option " << a << "\n"; return false; }
+    }
+    for (auto &c : cfg.corpora)
+        if (c != "random" && c != "dna" && c != "periodic" && c != "english") {
+            cerr << "Unknown corpus '" << c << "'\n"; return false;
+        }
+    for (auto &e : cfg.engines)
+        if (e != "naive" && e != "kmp" && e != "rabin-karp" && e != "shift-and" && e != "myers" &&
+            e != "aho" && e != "teddy" && e != "lcs") {
+            cerr << "Unknown engine '" << e << "'\n"; return false;
+        }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    Config cfg;
+    if (!parseArgs(argc, argv, cfg)) return 1;
+
+    vector<Result> results;
+    for (const string &corpus : cfg.corpora) {
+        for (size_t size : cfg.sizes) {
+            Rng textRng(mixSeed(cfg.seed, corpus, size));
+            string text = genCorpus(corpus, size, textRng);
+            for (const string &engine : cfg.engines) {
+                // the single-pattern engines share one pattern and aho / teddy share one
+                // dictionary, so match counts are comparable and an --engines subset
+                // reproduces the same cases
+                bool dict = engine == "aho" || engine == "teddy";
+                Rng rng(mixSeed(cfg.seed, corpus + (dict ? "/aho" : "/pattern"), size));
+                cerr << "[bench] " << engine << " / " << corpus << " / " << size << " bytes\n";
+                if (engine == "aho") {
+                    results.push_back(runAho(cfg, corpus, text, rng));
+                } else if (engine == "teddy") {
+                    results.push_back(runTeddy(cfg, corpus, text, rng));
+                    if (results.back().skipped)
+                        cerr << "[bench] teddy skipped: no printable dictionary (Teddy takes bytes 32..126 only)\n";
+                } else if (engine == "lcs") {
+                    if (size > cfg.lcsMax) continue;
+                    Rng rngB(mixSeed(cfg.seed ^ 1, corpus, size));
+                    string other = genCorpus(corpus, size, rngB);
+                    results.push_back(runLCS(cfg, corpus, text, other));
+                } else {
+                    results.push_back(runSingle(cfg, engine, corpus, text, rng));
+                }
+            }
+        }
+    }
+
+    if (cfg.out.empty()) {
+        writeJSON(cout, cfg, results);
+    } else {
+        ofstream f(cfg.out);
+        if (!f.is_open()) { cerr << "Error: Could not open file '" << cfg.out << "'\n"; return 1; }
+        writeJSON(f, cfg, results);
+    }
+    return 0;
+}
@@ -0,0 +1,440 @@
+/*
+Differential checks for the engines whose correctness is not obvious from
+reading them: each is compared with a slow, plainly correct reference on
+seeded random inputs.
+- approx: shiftAndScan (k mismatches) and myersScan (k edits) against an
+  O(n * m) reference; patterns run up to 150 chars so the multi-word
+  (m > 64) paths are covered, and k goes past m to cover the clamp.
+- fm: saIs against a comparison sort of all suffixes, then FMIndex count /
+  locate against std::string::find, over alphabets from 1 symbol to all
+  256 bytes and sample rates 1..40 (the index goes through a temp file);
+  FMIndex::open must also refuse headers with corrupted fields.
+- teddy: every Teddy kernel this CPU runs (scalar, SSSE3, AVX2, forced
+  through scanAt) against Aho::scan, on mixed-case dictionaries of 1..64
+  literals and texts whose lengths straddle the 16 / 32 byte blocks.
+- scan: Scan_23I-0782's engine setup, which must refuse patterns its
+  set engines cannot match instead of reporting wrong offsets, and auto's
+  Teddy / Aho routing for 1-2 keyword sets and for unselective inputs.
+
+Build:
+    g++ -O2 -std=c++17 -pthread Check_23I-0782.cpp -o output/Check_23I-0782
+
+Usage:
+    Check_23I-0782 [--seed 42] [--rounds 200] [--only approx,fm,teddy,scan]
+Prints one line per group plus the inputs of the first failures.
+Exit status: 0 if every check passed, 1 otherwise.
+*/
+
+#include "MappedFile_23I-0782.h"
+
+#define STRMATCH_NO_MAIN
+#include "Scan_23I-0782.cpp"  // with Q1, Q3 and Teddy
+#include "Index_23I-0782.cpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <sstream>
+
+// -----------------------------
+// Shared helpers
+// -----------------------------
+struct Rng {
+    mt19937_64 eng;
+    explicit Rng(uint64_t seed) : eng(seed) {}
+    uint64_t below(uint64_t bound) { return eng() % bound; }
+};
+
+// first `alpha` symbols of a fixed alphabet; small alphabets give many matches
+string randomText(Rng &rng, int n, int alpha) {
+    static const string SYMBOLS = "acgtbdefhijklmnopqrsuvwxyz";
+    string s(n, 'a');
+    for (char &c : s) c = SYMBOLS[rng.below(alpha)];
+    return s;
+}
+
+// alpha == 256: arbitrary bytes, including 0 and 255
+string randomBytes(Rng &rng, int n, int alpha) {
+    if (alpha < 256) return randomText(rng, n, alpha);
+    string s(n, '\0');
+    for (char &c : s) c = (char)rng.below(256);
+    return s;
+}
+
+// Counts cases per group and keeps the first few failure descriptions
+struct Group {
+    string name;
+    long long cases = 0, failures = 0;
+    vector<string> samples;
+
+    explicit Group(const string &n) : name(n) {}
+    void check(bool ok, const string &what) {
+        ++cases;
+        if (ok) return;
+        ++failures;
+        if (samples.size() < 5) samples.push_back(what);
+    }
+    bool report() const {
+        cout << name << ": " << cases << " cases, " << failures << " failed\n";
+        for (const string &s : samples) cout << "  " << s << "\n";
+        return failures == 0;
+    }
+};
+
+static string describe(const string &text, const string &pattern, int k) {
+    ostringstream os;
+    os << "text=\"" << (text.size() > 80 ? text.substr(0, 80) + "..." : text) << "\" (n=" << text.size()
+       << ") pattern=\"" << pattern << "\" (m=" << pattern.size() << ") k=" << k;
+    return os.str();
+}
+
+// -----------------------------
+// approx: Shift-And / Myers
+// -----------------------------
+// (start, mismatches) for every window with at most k mismatches
+vector<pair<int, int>> hammingReference(const string &text, const string &pattern, int k) {
+    vector<pair<int, int>> out;
+    int n = text.size(), m = pattern.size();
+    for (int i = 0; i + m <= n; i++) {
+        int d = 0;
+        for (int j = 0; j < m; j++)
+            d += text[i + j] != pattern[j];
+        if (d <= k)
+            out.push_back({i, d});
+    }
+    return out;
+}
+
+// (end, distance) for every end with best edit distance <= k (Sellers' DP)
+vector<pair<int, int>> editReference(const string &text, const string &pattern, int k) {
+    vector<pair<int, int>> out;
+    int n = text.size(), m = pattern.size();
+    vector<int> col(m + 1), next(m + 1);
+    for (int j = 0; j <= m; j++)
+        col[j] = j;
+    for (int i = 0; i < n; i++) {
+        next[0] = 0;
+        for (int j = 1; j <= m; j++)
+            next[j] = min({col[j] + 1, next[j - 1] + 1, col[j - 1] + (text[i] != pattern[j - 1])});
+        swap(col, next);
+        if (col[m] <= k)
+            out.push_back({i, col[m]});
+    }
+    return out;
+}
+
+bool checkApprox(uint64_t seed, int rounds) {
+    Group hamming("approx/shift-and"), edit("approx/myers");
+    Rng rng(seed);
+    static const int EDGE_LENGTHS[] = {1, 2, 63, 64, 65, 127, 128, 129, 150};
+    static const int ALPHABETS[] = {2, 4, 26};
+    for (int r = 0; r < rounds; r++) {
+        int alpha = ALPHABETS[r % 3];
+        int m = (r % 4 == 0) ? EDGE_LENGTHS[rng.below(9)] : 1 + (int)rng.below(150);
+        int n = (int)rng.below(2 * m + 400);
+        string text = randomText(rng, n, alpha);
+        string pattern = randomText(rng, m, alpha);
+        // plant a few near-copies so matches with d > 0 actually occur
+        for (int c = 0; c < 3 && n >= m; c++) {
+            int at = (int)rng.below(n - m + 1);
+            for (int j = 0; j < m; j++)
+                text[at + j] = rng.below(10) ? pattern[j] : randomText(rng, 1, alpha)[0];
+        }
+        int k = (r % 10 == 9) ? m + (int)rng.below(3) : (int)rng.below(min(m, 8) + 1);
+        if (r % 50 == 49)
+            k = INT_MAX;
+
+        vector<pair<int, int>> got;
+        shiftAndScan(text, pattern, k, [&](int i, int d) { got.push_back({i, d}); });
+        hamming.check(got == hammingReference(text, pattern, k), describe(text, pattern, k));
+
+        got.clear();
+        myersScan(text, pattern, k, [&](int i, int d) { got.push_back({i, d}); });
+        edit.check(got == editReference(text, pattern, k), describe(text, pattern, k));
+    }
+    bool ok = hamming.report();
+    return edit.report() && ok;
+}
+
+// -----------------------------
+// fm: SA-IS and FMIndex
+// -----------------------------
+vector<int> suffixArrayReference(const vector<int> &s) {
+    vector<int> sa(s.size());
+    for (int i = 0; i < (int)sa.size(); ++i) sa[i] = i;
+    sort(sa.begin(), sa.end(), [&](int a, int b) {
+        return lexicographical_compare(s.begin() + a, s.end(), s.begin() + b, s.end());
+    });
+    return sa;
+}
+
+vector<uint64_t> locateReference(const string &text, const string &pattern) {
+    vector<uint64_t> pos;
+    for (size_t at = text.find(pattern); at != string::npos; at = text.find(pattern, at + 1))
+        pos.push_back(at);
+    return pos;
+}
+
+bool checkFM(uint64_t seed, int rounds) {
+    Group sais("fm/sa-is"), count("fm/count"), locate("fm/locate");
+    Rng rng(seed ^ 0xF00D);
+    static const int UPPERS[] = {0, 1, 3, 255, 1000};
+    for (int r = 0; r < rounds; ++r) {
+        // periodic inputs make SA-IS recurse several levels
+        int upper = UPPERS[r % 5];
+        int n = (int)rng.below(r % 7 == 0 ? 12 : 2000);
+        vector<int> s(n);
+        int period = 1 + (int)rng.below(r % 2 ? 5 : n + 1);
+        for (int i = 0; i < n; ++i) s[i] = i >= period ? s[i - period] : (int)rng.below(upper + 1);
+        if (n && r % 3 == 0) s[rng.below(n)] = (int)rng.below(upper + 1);
+        sais.check(saIs(s, upper) == suffixArrayReference(s),
+                   "n=" + to_string(n) + " upper=" + to_string(upper) + " period=" + to_string(period));
+    }
+
+    string path = (filesystem::temp_directory_path() / "Check_23I-0782.fmidx").string();
+    static const int ALPHABETS[] = {1, 2, 4, 26, 256};
+    for (int r = 0; r < rounds; ++r) {
+        int alpha = ALPHABETS[r % 5];
+        int n = (r % 20 == 0) ? (int)rng.below(3) : (int)rng.below(3000);
+        string text = randomBytes(rng, n, alpha);
+        uint32_t sampleRate = (r % 10 == 9) ? 1000 : 1 + r % 40;
+
+        string err;
+        FMIndex idx;
+        string what = "n=" + to_string(n) + " alpha=" + to_string(alpha) + " sample=" + to_string(sampleRate);
+        if (!buildIndex(text, path, sampleRate, err) || !idx.open(path, err)) {
+            count.check(false, what + ": " + err);
+            continue;
+        }
+        for (int q = 0; q < 20; ++q) {
+            string pattern;
+            if (q < 12 && n > 0) {
+                int len = 1 + (int)rng.below(min(n, 20));
+                pattern = text.substr(rng.below(n - len + 1), len);
+            } else {
+                pattern = randomBytes(rng, 1 + (int)rng.below(4), alpha == 256 ? 256 : alpha + 1);
+            }
+            vector<uint64_t> expect = locateReference(text, pattern);
+            string desc = what + " pattern length " + to_string(pattern.size());
+            count.check(idx.count(pattern) == expect.size(), desc);
+            locate.check(idx.locate(pattern) == expect, desc);
+        }
+    }
+
+    // corrupt one header field at a time; open() has to refuse every variant
+    Group corrupt("fm/corrupt-header");
+    string err;
+    if (buildIndex(randomText(rng, 5000, 4), path, 32, err)) {
+        string good;
+        {
+            ifstream in(path, ios::binary);
+            good.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        }
+        using Mutate = void (*)(IndexHeader &);
+        const pair<const char *, Mutate> MUTATIONS[] = {
+            {"block = 0", [](IndexHeader &h) { h.block = 0; }},
+            {"sampleRate = 0", [](IndexHeader &h) { h.sampleRate = 0; }},
+            {"sigma = 300", [](IndexHeader &h) { h.sigma = 300; }},
+            {"byte order swapped", [](IndexHeader &h) { h.byteOrder = 0x04030201; }},
+            {"n + 1000", [](IndexHeader &h) { h.n += 1000; }},
+            {"primary past n", [](IndexHeader &h) { h.primary = h.n + 1; }},
+            {"occOff past file", [](IndexHeader &h) { h.occOff = h.fileSize + 8; }},
+            {"markOff before occOff", [](IndexHeader &h) { h.markOff = h.occOff; }},
+            {"samplesOff misaligned", [](IndexHeader &h) { h.samplesOff += 4; }},
+            {"samplesCount + 1", [](IndexHeader &h) { h.samplesCount++; }},
+            {"C not increasing", [](IndexHeader &h) { h.C[100] = h.C[101] + 1; }},
+            {"code past sigma", [](IndexHeader &h) { h.code['a'] = 200; }},
+        };
+        for (auto &m : MUTATIONS) {
+            string bytes = good;
+            m.second(*(IndexHeader *)&bytes[0]);
+            ofstream(path, ios::binary) << bytes;
+            FMIndex idx;
+            corrupt.check(!idx.open(path, err), string("accepted: ") + m.first);
+        }
+        ofstream(path, ios::binary) << good.substr(0, good.size() - 4);
+        FMIndex truncated, intact;
+        corrupt.check(!truncated.open(path, err), "accepted: truncated file");
+        ofstream(path, ios::binary) << good;
+        corrupt.check(intact.open(path, err), "refused the unmodified index: " + err);
+    } else {
+        corrupt.check(false, "build failed: " + err);
+    }
+    error_code ec;
+    filesystem::remove(path, ec);
+
+    bool ok = sais.report();
+    ok = count.report() && ok;
+    ok = locate.report() && ok;
+    return corrupt.report() && ok;
+}
+
+// -----------------------------
+// teddy: SIMD kernels against Aho
+// -----------------------------
+// printable bytes other than '?' (Aho's wildcard), weighted towards
+// letters so case folding is exercised
+char randomPrintable(Rng &rng) {
+    static const string LETTERS = "abcdeABCDEzZ";
+    char c = rng.below(2) ? LETTERS[rng.below(LETTERS.size())] : (char)(32 + rng.below(95));
+    return c == '?' ? '!' : c;
+}
+
+bool checkTeddy(uint64_t seed, int rounds) {
+    static const char *const KERNELS[] = {"teddy/scalar", "teddy/ssse3", "teddy/avx2"};
+    vector<Group> groups;
+    for (int level = 0; level <= Teddy::cpuLevel(); ++level) groups.emplace_back(KERNELS[level]);
+    Rng rng(seed ^ 0x7EDD);
+
+    for (int r = 0; r < rounds; ++r) {
+        int count = 1 + (int)rng.below(r % 4 == 0 ? Teddy::MAX_PATTERNS : 8);
+        vector<string> patterns;
+        for (int i = 0; i < count; ++i) {
+            // some patterns extend or repeat earlier ones, so buckets overlap
+            string p;
+            if (i > 0 && rng.below(4) == 0) p = patterns[rng.below(i)];
+            int len = (r % 5 == 0 && i == 0) ? 1 + (int)rng.below(3) : 1 + (int)rng.below(12);
+            while ((int)p.size() < len || p.empty()) p += randomPrintable(rng);
+            patterns.push_back(p);
+        }
+
+        int n = (int)rng.below(r % 3 == 0 ? 70 : 600);
+        string text(n, ' ');
+        for (char &c : text)
+            c = rng.below(8) ? randomPrintable(rng) : (char)rng.below(256);  // high bytes share nibbles
+        for (int c = 0; c < 6 && n > 0; ++c) {
+            const string &p = patterns[rng.below(count)];
+            if ((int)p.size() > n) continue;
+            size_t at = rng.below(n - p.size() + 1);
+            for (size_t j = 0; j < p.size(); ++j)
+                text[at + j] = rng.below(2) ? (char)toupper((unsigned char)p[j]) : p[j];
+        }
+
+        Aho aho;
+        for (int i = 0; i < count; ++i) {
+            string p = patterns[i];
+            for (char &ch : p) ch = norm_char(ch);
+            aho.insert_pattern(p, i);
+        }
+        aho.build_links();
+        vector<pair<int, int>> expect;
+        aho.scan(text, [&](int end, int pid) { expect.push_back({end, pid}); });
+        sort(expect.begin(), expect.end());
+
+        Teddy teddy;
+        string what = to_string(count) + " patterns, n=" + to_string(n) + ", first \"" + patterns[0] + "\"";
+        if (!teddy.build(patterns)) {
+            groups[0].check(false, what + ": build rejected an eligible set");
+            continue;
+        }
+        for (int level = 0; level < (int)groups.size(); ++level) {
+            vector<pair<int, int>> got;
+            teddy.scanAt(level, text, [&](int end, int pid) { got.push_back({end, pid}); });
+            sort(got.begin(), got.end());
+            groups[level].check(got == expect, what);
+        }
+    }
+    bool ok = true;
+    for (const Group &g : groups) ok = g.report() && ok;
+    return ok;
+}
+
+// -----------------------------
+// scan: engine setup
+// -----------------------------
+bool checkScan() {
+    Group setupGroup("scan/setup");
+    struct Case {
+        vector<string> patterns;
+        Engine requested;
+        bool accepted;
+    };
+    // Aho's alphabet is printable ASCII, so UTF-8 or tabs must go to an exact engine
+    const Case CASES[] = {
+        {{"caf\xC3\xA9"}, ENGINE_AUTO, false},
+        {{"caf\xC3\xA9"}, ENGINE_AHO, false},
+        {{"caf\xC3\xA9"}, ENGINE_TEDDY, false},
+        {{"caf\xC3\xA9"}, ENGINE_KMP, true},
+        {{"library", "a\tb"}, ENGINE_AUTO, false},
+        {{"library", "a\tb"}, ENGINE_NAIVE, true},
+        {{"library", "the"}, ENGINE_AUTO, true},
+        {{"lib?ary"}, ENGINE_AHO, true},
+    };
+    for (const Case &c : CASES) {
+        ScanSetup setup;
+        setup.patterns = c.patterns;
+        string err;
+        bool accepted = prepareScan(setup, c.requested, "", err);
+        setupGroup.check(accepted == c.accepted, string(ENGINE_NAMES[c.requested]) + " on \"" +
+                                                     c.patterns.back() + "\": " + (accepted ? "accepted" : err));
+    }
+
+    // auto routing: Teddy for one or two keywords on prose, Aho where almost
+    // every position would be a candidate
+    Group routing("scan/routing");
+    Rng rng(7);
+    string prose, dna = randomText(rng, 1 << 16, 4), periodic;
+    static const char *const WORDS[] = {"the", "of", "and", "to", "a", "in", "is", "that", "for", "it",
+                                        "was", "library", "river", "merchants", "stone", "water"};
+    while (prose.size() < (1 << 16)) prose += string(WORDS[rng.below(16)]) + (rng.below(10) ? " " : ". ");
+    while (periodic.size() < (1 << 16)) periodic += "abca";
+    struct Route {
+        vector<string> patterns;
+        const string *sample;
+        Engine expect;
+    };
+    const Route ROUTES[] = {
+        {{"the"}, &prose, ENGINE_TEDDY},
+        {{"error"}, &prose, ENGINE_TEDDY},
+        {{"the", "and"}, &prose, ENGINE_TEDDY},
+        {{"error", "fatal"}, &prose, ENGINE_TEDDY},
+        {{"the"}, nullptr, ENGINE_TEDDY},
+        {{"error"}, nullptr, ENGINE_TEDDY},
+        {{"the", "e"}, &prose, ENGINE_AHO},
+        {{"abcaabca"}, &periodic, ENGINE_AHO},
+        {{}, &dna, ENGINE_AHO},
+    };
+    for (const Route &rt : ROUTES) {
+        vector<string> patterns = rt.patterns;
+        if (patterns.empty())  // 16 DNA literals: too many candidates on DNA
+            for (int i = 0; i < 16; ++i) patterns.push_back(dna.substr(rng.below(dna.size() - 12), 12));
+        Teddy teddy;
+        Engine got = resolveEngine(patterns, ENGINE_AUTO, teddy, rt.sample ? string_view(*rt.sample) : "");
+        routing.check(got == rt.expect, "\"" + patterns[0] + "\" x" + to_string(patterns.size()) + " routed to " +
+                                            ENGINE_NAMES[got] + " (candidate rate " + to_string(teddy.candidateRate) + ")");
+    }
+    bool ok = setupGroup.report();
+    return routing.report() && ok;
+}
+
+// -----------------------------
+// Main
+// -----------------------------
+int main(int argc, char **argv) {
+    uint64_t seed = 42;
+    int rounds = 200;
+    vector<string> only;
+    for (int i = 1; i < argc; i += 2) {
+        string a = argv[i], v = i + 1 < argc ? argv[i + 1] : "";
+        if (v.empty()) a.clear();  // missing value: fall through to usage
+        if (a == "--seed") seed = strtoull(v.c_str(), nullptr, 10);
+        else if (a == "--rounds") rounds = max(1, atoi(v.c_str()));
+        else if (a == "--only") {
+            stringstream ss(v);
+            string item;
+            while (getline(ss, item, ',')) only.push_back(item);
+        } else {
+            cerr << "Usage: Check_23I-0782 [--seed 42] [--rounds 200] [--only approx,fm,teddy,scan]\n";
+            return 1;
+        }
+    }
+    auto wanted = [&](const string &g) { return only.empty() || find(only.begin(), only.end(), g) != only.end(); };
+
+    bool ok = true;
+    if (wanted("approx")) ok = checkApprox(seed, rounds) && ok;
+    if (wanted("fm")) ok = checkFM(seed, rounds) && ok;
+    if (wanted("teddy")) ok = checkTeddy(seed, rounds) && ok;
+    if (wanted("scan")) ok = checkScan() && ok;
+    cout << (ok ? "all checks passed\n" : "FAILURES\n");
+    return ok ? 0 : 1;
+}
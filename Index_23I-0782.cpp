@@ -0,0 +1,462 @@
+/*
+FM-index over a text file for repeated exact queries.
+- build: suffix array by SA-IS (linear time), then BWT, rank checkpoints and
+  a sampled suffix array, written to one flat file.
+- count:  backward search, O(m) rank steps independent of the text size.
+- locate: count, then walk LF from each row to the nearest sampled row
+  (at most sample_rate - 1 steps per occurrence).
+The index file is memory-mapped at query time; nothing is parsed or copied,
+so a query process starts in O(1). Matching is exact and case-sensitive,
+like the Q1 engines; for one-off scans those remain the better choice.
+
+Build:
+    g++ -O2 -std=c++17 Index_23I-0782.cpp -o output/Index_23I-0782
+
+Usage:
+    Index_23I-0782 build  <text-file> <index-file> [--sample 32]
+    Index_23I-0782 count  <index-file> [pattern...]
+    Index_23I-0782 locate <index-file> [pattern...]
+With no patterns on the command line, count / locate read one pattern per
+line from stdin, so a long-running process can serve a query stream.
+
+Output (tab-separated, pattern ids follow input order):
+    count:  <pattern_id>	<count>	<pattern>
+    locate: <pattern_id>	<start_index>	<pattern>     (ascending per pattern)
+Every query, empty lines included, takes the next id and count answers
+each one with exactly one row; an empty pattern matches nothing.
+
+File layout (native byte order, recorded in the header; every section
+8-byte aligned; open() checks the header against the file before use):
+    IndexHeader | BWT (n + 1 bytes) | occ checkpoints (uint32, sigma per block)
+    | sampled-row bitmap (uint64 words) | bitmap rank per word (uint32)
+    | SA samples (uint32)
+*/
+
+#include "MappedFile_23I-0782.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+// -----------------------------
+// SA-IS suffix array construction
+// -----------------------------
+// s holds symbols in [0, upper]; returns the suffix array of s.
+// Time: O(n), extra space: O(n) ints per recursion level (levels halve).
+vector<int> saIs(const vector<int> &s, int upper) {
+    int n = (int)s.size();
+    if (n == 0) return {};
+    if (n == 1) return {0};
+    if (n < 10) {
+        // tiny inputs: plain comparison sort
+        vector<int> sa(n);
+        for (int i = 0; i < n; ++i) sa[i] = i;
+        sort(sa.begin(), sa.end(), [&](int a, int b) {
+            return lexicographical_compare(s.begin() + a, s.end(), s.begin() + b, s.end());
+        });
+        return sa;
+    }
+
+    vector<int> sa(n);
+    vector<bool> ls(n, false);  // true = S-type suffix
+    for (int i = n - 2; i >= 0; --i)
+        ls[i] = (s[i] == s[i + 1]) ? ls[i + 1] : (s[i] < s[i + 1]);
+
+    // bucket boundaries: sum_l[c] = start of c's bucket, sum_s[c] = start of its S part
+    vector<int> sum_l(upper + 1, 0), sum_s(upper + 1, 0);
+    for (int i = 0; i < n; ++i) {
+        if (!ls[i]) sum_s[s[i]]++;
+        else sum_l[s[i] + 1]++;
+    }
+    for (int i = 0; i <= upper; ++i) {
+        sum_s[i] += sum_l[i];
+        if (i < upper) sum_l[i + 1] += sum_s[i];
+    }
+
+    auto induce = [&](const vector<int> &lms) {
+        fill(sa.begin(), sa.end(), -1);
+        vector<int> buf(sum_s);
+        for (int d : lms)
+            if (d != n) sa[buf[s[d]]++] = d;
+        buf = sum_l;
+        sa[buf[s[n - 1]]++] = n - 1;
+        for (int i = 0; i < n; ++i) {
+            int v = sa[i];
+            if (v >= 1 && !ls[v - 1]) sa[buf[s[v - 1]]++] = v - 1;
+        }
+        buf = sum_l;
+        for (int i = n - 1; i >= 0; --i) {
+            int v = sa[i];
+            if (v >= 1 && ls[v - 1]) sa[--buf[s[v - 1] + 1]] = v - 1;
+        }
+    };
+
+    // LMS positions: S-type with an L-type predecessor
+    vector<int> lms_map(n + 1, -1), lms;
+    int m = 0;
+    for (int i = 1; i < n; ++i)
+        if (!ls[i - 1] && ls[i]) lms_map[i] = m++;
+    lms.reserve(m);
+    for (int i = 1; i < n; ++i)
+        if (!ls[i - 1] && ls[i]) lms.push_back(i);
+
+    induce(lms);
+
+    if (m) {
+        // name LMS substrings in sorted order, recurse if names collide
+        vector<int> sorted_lms;
+        sorted_lms.reserve(m);
+        for (int v : sa)
+            if (lms_map[v] != -1) sorted_lms.push_back(v);
+        vector<int> rec_s(m);
+        int rec_upper = 0;
+        rec_s[lms_map[sorted_lms[0]]] = 0;
+        for (int i = 1; i < m; ++i) {
+            int l = sorted_lms[i - 1], r = sorted_lms[i];
+            int end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
+            int end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
+            bool same = true;
+            if (end_l - l != end_r - r) {
+                same = false;
+            } else {
+                while (l < end_l && s[l] == s[r]) { ++l; ++r; }
+                if (l == n || s[l] != s[r]) same = false;
+            }
+            if (!same) ++rec_upper;
+            rec_s[lms_map[sorted_lms[i]]] = rec_upper;
+        }
+        vector<int> rec_sa = saIs(rec_s, rec_upper);
+        for (int i = 0; i < m; ++i) sorted_lms[i] = lms[rec_sa[i]];
+        induce(sorted_lms);
+    }
+    return sa;
+}
+
+// -----------------------------
+// On-disk layout
+// -----------------------------
+static const char INDEX_MAGIC[8] = {'F', 'M', 'I', 'D', 'X', '0', '2', '\0'};
+static const uint32_t INDEX_BYTE_ORDER = 0x01020304;  // reads back as 0x04030201 when swapped
+
+struct IndexHeader {
+    char magic[8];
+    uint64_t n;            // text length; the BWT has n + 1 rows (sentinel included)
+    uint64_t primary;      // BWT row whose suffix is the whole text (its BWT char is the sentinel)
+    uint32_t sigma;        // distinct byte values in the text
+    uint32_t block;        // rows per occ checkpoint
+    uint32_t sampleRate;   // text positions divisible by this are sampled
+    uint32_t byteOrder;    // INDEX_BYTE_ORDER as written by the builder
+    uint64_t C[257];       // C[c] = rows whose suffix starts with a byte < c (sentinel row included)
+    uint8_t code[256];     // byte -> dense column in the occ table (valid where the byte occurs)
+    uint64_t bwtOff, occOff, markOff, markRankOff, samplesOff, samplesCount;
+    uint64_t fileSize;
+};
+
+static uint64_t align8(uint64_t x) { return (x + 7) & ~7ULL; }
+
+// Section sizes implied by the header; the builder and the validator share them
+static uint64_t occBlocks(const IndexHeader &h) { return (h.n + 1) / h.block + 1; }
+static uint64_t markWordCount(const IndexHeader &h) { return (h.n + 1) / 64 + 1; }
+
+// Every field the query paths index with, checked against the file size so a
+// corrupt or foreign index is refused instead of read out of bounds
+static bool validateHeader(const IndexHeader &h, uint64_t fileSize, string &err) {
+    if (h.byteOrder != INDEX_BYTE_ORDER) {
+        err = h.byteOrder == 0x04030201 ? "index was written with the other byte order" : "unsupported index format";
+        return false;
+    }
+    if (h.fileSize != fileSize) { err = "index file is truncated"; return false; }
+    if (h.n >= (uint64_t)INT_MAX || h.block == 0 || h.sampleRate == 0 || h.sigma > 256 ||
+        h.primary > h.n) {
+        err = "corrupt index header";
+        return false;
+    }
+    uint64_t rows = h.n + 1;
+    if (h.C[0] != 1 || h.C[256] != rows) { err = "corrupt index header"; return false; }
+    uint32_t present = 0;
+    for (int c = 0; c < 256; ++c) {
+        if (h.C[c + 1] < h.C[c]) { err = "corrupt index header"; return false; }
+        if (h.C[c + 1] > h.C[c]) {
+            if (h.code[c] >= h.sigma) { err = "corrupt index header"; return false; }
+            ++present;
+        }
+    }
+    if (present != h.sigma || h.samplesCount != h.n / h.sampleRate + 1) {
+        err = "corrupt index header";
+        return false;
+    }
+
+    // sections in order, aligned, each large enough for what n implies, all inside the file
+    uint64_t sigma = max(1u, h.sigma);
+    const uint64_t offs[5] = {h.bwtOff, h.occOff, h.markOff, h.markRankOff, h.samplesOff};
+    const uint64_t sizes[5] = {rows, occBlocks(h) * sigma * sizeof(uint32_t), markWordCount(h) * sizeof(uint64_t),
+                               markWordCount(h) * sizeof(uint32_t), h.samplesCount * sizeof(uint32_t)};
+    uint64_t end = sizeof(IndexHeader);
+    for (int i = 0; i < 5; ++i) {
+        if (offs[i] % 8 || offs[i] < end || offs[i] > fileSize || sizes[i] > fileSize - offs[i]) {
+            err = "corrupt index layout";
+            return false;
+        }
+        end = offs[i] + sizes[i];
+    }
+    return true;
+}
+
+// -----------------------------
+// FMIndex: read-only view over a mapped index file
+// -----------------------------
+struct FMIndex {
+    MappedFile file;
+    const IndexHeader *hdr = nullptr;
+    const uint8_t *bwt = nullptr;
+    const uint32_t *occ = nullptr;
+    const uint64_t *mark = nullptr;
+    const uint32_t *markRank = nullptr;
+    const uint32_t *samples = nullptr;
+
+    bool open(const string &path, string &err) {
+        if (!file.open(path)) { err = file.error; return false; }
+        if (file.size < sizeof(IndexHeader)) { err = "not an index file"; return false; }
+        hdr = (const IndexHeader *)file.data;
+        if (memcmp(hdr->magic, INDEX_MAGIC, 8) != 0) { err = "not an index file"; return false; }
+        if (!validateHeader(*hdr, file.size, err)) return false;
+        bwt = (const uint8_t *)(file.data + hdr->bwtOff);
+        occ = (const uint32_t *)(file.data + hdr->occOff);
+        mark = (const uint64_t *)(file.data + hdr->markOff);
+        markRank = (const uint32_t *)(file.data + hdr->markRankOff);
+        samples = (const uint32_t *)(file.data + hdr->samplesOff);
+        return true;
+    }
+
+    // occurrences of byte c in bwt[0, i), not counting the sentinel row
+    uint64_t rank(uint8_t c, uint64_t i) const {
+        uint64_t b = i / hdr->block;
+        uint64_t r = occ[b * hdr->sigma + hdr->code[c]];
+        for (uint64_t j = b * hdr->block; j < i; ++j)
+            r += (bwt[j] == c);
+        if (hdr->primary < i && hdr->primary >= b * hdr->block && bwt[hdr->primary] == c)
+            --r;
+        return r;
+    }
+
+    bool present(uint8_t c) const { return hdr->C[c + 1] > hdr->C[c]; }
+
+    // backward search; [sp, ep) is the range of rows prefixed by pattern
+    bool range(const string &pattern, uint64_t &sp, uint64_t &ep) const {
+        sp = 0;
+        ep = hdr->n + 1;
+        for (int i = (int)pattern.size() - 1; i >= 0 && sp < ep; --i) {
+            uint8_t c = (uint8_t)pattern[i];
+            if (!present(c)) return false;
+            sp = hdr->C[c] + rank(c, sp);
+            ep = hdr->C[c] + rank(c, ep);
+        }
+        return sp < ep;
+    }
+
+    uint64_t count(const string &pattern) const {
+        uint64_t sp, ep;
+        return range(pattern, sp, ep) ? ep - sp : 0;
+    }
+
+    bool marked(uint64_t row) const { return (mark[row >> 6] >> (row & 63)) & 1; }
+
+    // text position of the suffix in BWT row `row`
+    uint64_t locateRow(uint64_t row) const {
+        uint64_t steps = 0;
+        while (!marked(row)) {
+            uint8_t c = bwt[row];
+            row = hdr->C[c] + rank(c, row);  // LF mapping
+            ++steps;
+        }
+        uint64_t word = row >> 6;
+        uint64_t before = markRank[word] + __builtin_popcountll(mark[word] & ((1ULL << (row & 63)) - 1));
+        return samples[before] + steps;
+    }
+
+    vector<uint64_t> locate(const string &pattern) const {
+        vector<uint64_t> pos;
+        uint64_t sp, ep;
+        if (!range(pattern, sp, ep)) return pos;
+        pos.reserve(ep - sp);
+        for (uint64_t row = sp; row < ep; ++row) pos.push_back(locateRow(row));
+        sort(pos.begin(), pos.end());
+        return pos;
+    }
+};
+
+// -----------------------------
+// Index construction
+// -----------------------------
+bool buildIndex(string_view text, const string &outPath, uint32_t sampleRate, string &err) {
+    const uint32_t BLOCK = 128;
+    uint64_t n = text.size();
+    uint64_t rows = n + 1;
+
+    IndexHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, INDEX_MAGIC, 8);
+    hdr.byteOrder = INDEX_BYTE_ORDER;
+    hdr.n = n;
+    hdr.block = BLOCK;
+    hdr.sampleRate = sampleRate;
+
+    // symbol counts -> C table and dense codes
+    uint64_t freq[256] = {};
+    for (char ch : text) freq[(uint8_t)ch]++;
+    hdr.C[0] = 1;  // sentinel row sorts first
+    for (int c = 0; c < 256; ++c) {
+        hdr.C[c + 1] = hdr.C[c] + freq[c];
+        if (freq[c]) hdr.code[c] = (uint8_t)hdr.sigma++;
+    }
+    uint32_t sigma = max(1u, hdr.sigma);
+
+    // suffix array of text + sentinel: row 0 is the sentinel suffix
+    vector<int> sa;
+    {
+        vector<int> s(n);
+        for (uint64_t i = 0; i < n; ++i) s[i] = (uint8_t)text[i];
+        sa = saIs(s, 255);
+    }
+
+    uint64_t numBlocks = occBlocks(hdr);
+    uint64_t markWords = markWordCount(hdr);
+    uint64_t samplesCount = n / sampleRate + 1;  // positions 0, r, 2r, ... <= n
+
+    hdr.bwtOff = align8(sizeof(IndexHeader));
+    hdr.occOff = align8(hdr.bwtOff + rows);
+    hdr.markOff = align8(hdr.occOff + numBlocks * sigma * sizeof(uint32_t));
+    hdr.markRankOff = align8(hdr.markOff + markWords * sizeof(uint64_t));
+    hdr.samplesOff = align8(hdr.markRankOff + markWords * sizeof(uint32_t));
+    hdr.samplesCount = samplesCount;
+    hdr.fileSize = hdr.samplesOff + samplesCount * sizeof(uint32_t);
+
+    vector<uint8_t> bwt(rows);
+    vector<uint32_t> occ(numBlocks * sigma, 0);
+    vector<uint64_t> mark(markWords, 0);
+    vector<uint32_t> markRank(markWords, 0);
+    vector<uint32_t> samples;
+    samples.reserve(samplesCount);
+
+    vector<uint32_t> running(sigma, 0);
+    for (uint64_t row = 0; row < rows; ++row) {
+        if (row % BLOCK == 0)
+            copy(running.begin(), running.end(), occ.begin() + (row / BLOCK) * sigma);
+        uint64_t pos = row == 0 ? n : (uint64_t)sa[row - 1];
+        if (pos == 0) {
+            hdr.primary = row;
+            bwt[row] = 0;  // placeholder; rank() skips this row
+        } else {
+            bwt[row] = (uint8_t)text[pos - 1];
+            running[hdr.code[bwt[row]]]++;
+        }
+        if (pos % sampleRate == 0) {
+            mark[row >> 6] |= 1ULL << (row & 63);
+            samples.push_back((uint32_t)pos);
+        }
+    }
+    if (rows % BLOCK == 0)
+        copy(running.begin(), running.end(), occ.begin() + (rows / BLOCK) * sigma);
+    uint32_t acc = 0;
+    for (uint64_t w = 0; w < markWords; ++w) {
+        markRank[w] = acc;
+        acc += __builtin_popcountll(mark[w]);
+    }
+
+    ofstream out(outPath, ios::binary);
+    if (!out.is_open()) { err = "cannot create '" + outPath + "'"; return false; }
+    auto writeAt = [&](uint64_t off, const void *p, uint64_t bytes) {
+        static const char zeros[8] = {};
+        uint64_t at = (uint64_t)out.tellp();
+        if (off > at) out.write(zeros, off - at);
+        out.write((const char *)p, bytes);
+    };
+    writeAt(0, &hdr, sizeof(hdr));
+    writeAt(hdr.bwtOff, bwt.data(), bwt.size());
+    writeAt(hdr.occOff, occ.data(), occ.size() * sizeof(uint32_t));
+    writeAt(hdr.markOff, mark.data(), mark.size() * sizeof(uint64_t));
+    writeAt(hdr.markRankOff, markRank.data(), markRank.size() * sizeof(uint32_t));
+    writeAt(hdr.samplesOff, samples.data(), samples.size() * sizeof(uint32_t));
+    if (!out) { err = "write failed for '" + outPath + "'"; return false; }
+    return true;
+}
+
+// -----------------------------
+// Main
+// Define STRMATCH_NO_MAIN to include this file from another driver.
+// -----------------------------
+#ifndef STRMATCH_NO_MAIN
+static void usage() {
+    cerr << "Usage: Index_23I-0782 build <text-file> <index-file> [--sample 32]\n"
+            "       Index_23I-0782 count|locate <index-file> [pattern...]\n";
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) { usage(); return 2; }
+    string cmd = argv[1];
+
+    if (cmd == "build") {
+        if (argc < 4) { usage(); return 2; }
+        uint32_t sampleRate = 32;
+        for (int i = 4; i + 1 < argc; ++i)
+            if (strcmp(argv[i], "--sample") == 0) sampleRate = (uint32_t)max(1, atoi(argv[++i]));
+        MappedFile text;
+        if (!text.open(argv[2])) { cerr << "Error: Could not open file '" << argv[2] << "'\n"; return 2; }
+        if (text.size >= (size_t)INT_MAX) { cerr << "Error: text too large (suffix array uses int)\n"; return 2; }
+
+        auto t0 = chrono::steady_clock::now();
+        string err;
+        if (!buildIndex(text.view(), argv[3], sampleRate, err)) { cerr << "Error: " << err << "\n"; return 2; }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        FMIndex idx;
+        if (!idx.open(argv[3], err)) { cerr << "Error: " << err << "\n"; return 2; }
+        cerr << "Indexed " << idx.hdr->n << " bytes (sigma " << idx.hdr->sigma << ") in " << ms
+             << " ms; index is " << idx.hdr->fileSize << " bytes\n";
+        return 0;
+    }
+
+    bool doLocate = cmd == "locate";
+    if (!doLocate && cmd != "count") { usage(); return 2; }
+
+    FMIndex idx;
+    string err;
+    if (!idx.open(argv[2], err)) { cerr << "Error: '" << argv[2] << "': " << err << "\n"; return 2; }
+
+    bool anyMatch = false;
+    int pid = 0;
+    auto query = [&](const string &pattern) {
+        if (pattern.empty()) {
+            if (!doLocate) cout << pid << "\t0\t\n";
+        } else if (doLocate) {
+            for (uint64_t pos : idx.locate(pattern)) {
+                cout << pid << '\t' << pos << '\t' << pattern << '\n';
+                anyMatch = true;
+            }
+        } else {
+            uint64_t c = idx.count(pattern);
+            cout << pid << '\t' << c << '\t' << pattern << '\n';
+            anyMatch |= c > 0;
+        }
+        ++pid;
+    };
+
+    if (argc > 3) {
+        for (int i = 3; i < argc; ++i) query(argv[i]);
+    } else {
+        string line;
+        while (getline(cin, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            query(line);
+            cout.flush();  // answer each streamed query immediately
+        }
+    }
+    return anyMatch ? 0 : 1;
+}
+#endif
@@ -0,0 +1,101 @@
+#ifndef MAPPEDFILE_23I_0782_H
+#define MAPPEDFILE_23I_0782_H
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX            // keep std::min / std::max usable
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+Read-only memory mapping of a whole file (mmap / MapViewOfFile).
+- open() returns false and fills error on failure.
+- Empty files open successfully with an empty view (nothing is mapped).
+- The mapping is released by the destructor; the object is move-only.
+- Include this before the Q*.cpp files: <windows.h> has to be seen before
+  their "using namespace std" (std::byte clashes with the Windows byte).
+*/
+struct MappedFile {
+    const char *data = nullptr;
+    size_t size = 0;
+    std::string error;
+
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&o) noexcept { swap(o); }
+    MappedFile &operator=(MappedFile &&o) noexcept { close(); swap(o); return *this; }
+    ~MappedFile() { close(); }
+
+    std::string_view view() const { return std::string_view(data, size); }
+
+#ifdef _WIN32
+    bool open(const std::string &path) {
+        close();
+        HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (f == INVALID_HANDLE_VALUE) { error = "cannot open"; return false; }
+        LARGE_INTEGER len;
+        if (!GetFileSizeEx(f, &len)) { CloseHandle(f); error = "cannot stat"; return false; }
+        size = (size_t)len.QuadPart;
+        if (size == 0) { CloseHandle(f); return true; }
+        HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(f);
+        if (!m) { size = 0; error = "cannot map"; return false; }
+        data = (const char *)MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(m);
+        if (!data) { size = 0; error = "cannot map"; return false; }
+        return true;
+    }
+
+    void close() {
+        if (data) UnmapViewOfFile(data);
+        data = nullptr;
+        size = 0;
+    }
+#else
+    bool open(const std::string &path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) { error = "cannot open"; return false; }
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); error = "cannot stat"; return false; }
+        size = (size_t)st.st_size;
+        if (size == 0) { ::close(fd); return true; }
+        void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) { size = 0; error = "cannot map"; return false; }
+        madvise(p, size, MADV_SEQUENTIAL);
+        data = (const char *)p;
+        return true;
+    }
+
+    void close() {
+        if (data) munmap((void *)data, size);
+        data = nullptr;
+        size = 0;
+    }
+#endif
+
+private:
+    void swap(MappedFile &o) {
+        std::swap(data, o.data);
+        std::swap(size, o.size);
+        std::swap(error, o.error);
+    }
+};
+
+#endif
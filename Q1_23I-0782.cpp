@@ -1,5 +1,11 @@
 #include <iostream>
 #include <vector>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include "Stats_23I-0782.h"
 using namespace std;
 
 // ---------------------------------------------------------
@@ -7,20 +13,33 @@ using namespace std;
 // ---------------------------------------------------------
 // Time Complexity: O(n * m)
 // Space Complexity: O(1)
-void naiveSearch(const string &text, const string &pattern) {
+// onMatch(i) is called for every index i where pattern occurs in text.
+// The *Scan cores take a string_view so mapped files can be scanned in place.
+template <typename OnMatch>
+void naiveScan(string_view text, const string &pattern, OnMatch onMatch) {
+    STAT_PHASE(PHASE_SEARCH);
     int n = text.size();
     int m = pattern.size();
-    bool found = false;
+    STAT_ADD(bytesScanned, n);
 
     for (int i = 0; i <= n - m; i++) {
         int j = 0;
         while (j < m && text[i + j] == pattern[j])
             j++;
+        STAT_ADD(charComparisons, j < m ? j + 1 : j);
         if (j == m) {
-            cout << "Pattern found at index " << i << " using Naive Search\n";
-            found = true;
+            STAT_ADD(matches, 1);
+            onMatch(i);
         }
     }
+}
+
+void naiveSearch(const string &text, const string &pattern) {
+    bool found = false;
+    naiveScan(text, pattern, [&](int i) {
+        cout << "Pattern found at index " << i << " using Naive Search\n";
+        found = true;
+    });
     if (!found)
         cout << "Pattern not found using Naive Search\n";
 }
@@ -30,6 +49,7 @@ void naiveSearch(const string &text, const string &pattern) {
 // ---------------------------------------------------------
 // Preprocessing: O(m), Search: O(n)
 vector<int> computeLPS(const string &pattern) {
+    STAT_PHASE(PHASE_PREPROCESS);
     int m = pattern.size();
     vector<int> lps(m, 0);
     int len = 0, i = 1;
@@ -46,27 +66,40 @@ vector<int> computeLPS(const string &pattern) {
     return lps;
 }
 
-void KMPsearch(const string &text, const string &pattern) {
+template <typename OnMatch>
+void KMPscan(string_view text, const string &pattern, OnMatch onMatch) {
     int n = text.size(), m = pattern.size();
     vector<int> lps = computeLPS(pattern);
+    STAT_PHASE(PHASE_SEARCH);
+    STAT_ADD(bytesScanned, n);
     int i = 0, j = 0;
-    bool found = false;
 
     while (i < n) {
+        STAT_ADD(charComparisons, 1);
         if (text[i] == pattern[j]) {
             i++; j++;
         }
         if (j == m) {
-            cout << "Pattern found at index " << i - j << " using KMP\n";
+            STAT_ADD(matches, 1);
+            onMatch(i - j);
             j = lps[j - 1];
-            found = true;
-        } else if (i < n && text[i] != pattern[j]) {
-            if (j != 0)
+            STAT_ADD(kmpFailureSteps, 1);
+        } else if (i < n && (STAT_ADD(charComparisons, 1), text[i] != pattern[j])) {
+            if (j != 0) {
                 j = lps[j - 1];
-            else
+                STAT_ADD(kmpFailureSteps, 1);
+            } else
                 i++;
         }
     }
+}
+
+void KMPsearch(const string &text, const string &pattern) {
+    bool found = false;
+    KMPscan(text, pattern, [&](int i) {
+        cout << "Pattern found at index " << i << " using KMP\n";
+        found = true;
+    });
     if (!found)
         cout << "Pattern not found using KMP\n";
 }
@@ -75,46 +108,241 @@ void KMPsearch(const string &text, const string &pattern) {
 // Rabin–Karp Algorithm
 // ---------------------------------------------------------
 // Average: O(n + m), Worst-case: O(n * m)
-void rabinKarpSearch(const string &text, const string &pattern) {
+// Characters are hashed as unsigned bytes so text outside ASCII keeps
+// pattern and window hashes in the same [0, q) range.
+template <typename OnMatch>
+void rabinKarpScan(string_view text, const string &pattern, OnMatch onMatch) {
     const int d = 256;  // number of possible characters
     const int q = 101;  // a prime number for hashing
     int n = text.size(), m = pattern.size();
+    if (m > n)
+        return;
 
     int p = 0, t = 0, h = 1;
-    bool found = false;
+    {
+        STAT_PHASE(PHASE_PREPROCESS);
+        for (int i = 0; i < m - 1; i++)
+            h = (h * d) % q;
 
-    for (int i = 0; i < m - 1; i++)
-        h = (h * d) % q;
-
-    for (int i = 0; i < m; i++) {
-        p = (d * p + pattern[i]) % q;
-        t = (d * t + text[i]) % q;
+        for (int i = 0; i < m; i++) {
+            p = (d * p + (unsigned char)pattern[i]) % q;
+            t = (d * t + (unsigned char)text[i]) % q;
+        }
     }
 
+    STAT_PHASE(PHASE_SEARCH);
+    STAT_ADD(bytesScanned, n);
     for (int i = 0; i <= n - m; i++) {
         if (p == t) {
+            STAT_ADD(rkHashHits, 1);
             bool match = true;
             for (int j = 0; j < m; j++) {
                 if (text[i + j] != pattern[j]) {
+                    STAT_ADD(charComparisons, j + 1);
                     match = false;
                     break;
                 }
             }
             if (match) {
-                cout << "Pattern found at index " << i << " using Rabin-Karp\n";
-                found = true;
+                STAT_ADD(charComparisons, m);
+                STAT_ADD(matches, 1);
+                onMatch(i);
+            } else {
+                STAT_ADD(rkFalsePositives, 1);
             }
         }
         if (i < n - m) {
-            t = (d * (t - text[i] * h) + text[i + m]) % q;
+            t = (d * (t - (unsigned char)text[i] * h) + (unsigned char)text[i + m]) % q;
             if (t < 0)
                 t += q;
         }
     }
+}
+
+void rabinKarpSearch(const string &text, const string &pattern) {
+    bool found = false;
+    rabinKarpScan(text, pattern, [&](int i) {
+        cout << "Pattern found at index " << i << " using Rabin-Karp\n";
+        found = true;
+    });
     if (!found)
         cout << "Pattern not found using Rabin-Karp\n";
 }
 
+// ---------------------------------------------------------
+// Approximate Matching (bit-parallel)
+// ---------------------------------------------------------
+// Patterns longer than 64 are split into 64-bit words: bit j of word w
+// stands for pattern[64 * w + j]. mask[c * words + w] has that bit set
+// where the pattern character equals c.
+vector<uint64_t> buildCharMasks(const string &pattern, int words) {
+    vector<uint64_t> mask(256 * words, 0);
+    for (int j = 0; j < (int)pattern.size(); j++)
+        mask[(unsigned char)pattern[j] * words + j / 64] |= 1ULL << (j % 64);
+    return mask;
+}
+
+// Shift-And with k mismatches (Hamming distance)
+// Time: O(n * (k + 1) * ceil(m / 64)), Space: O((256 + k) * ceil(m / 64))
+// R[d] bit j is set when pattern[0..j] ends at the current text position
+// with at most d mismatches. onMatch(start, mismatches) reports the
+// smallest d for each window.
+template <typename OnMatch>
+void shiftAndScan(string_view text, const string &pattern, int k, OnMatch onMatch) {
+    STAT_PHASE(PHASE_SEARCH);
+    int n = text.size(), m = pattern.size();
+    if (m == 0 || m > n)
+        return;
+    STAT_ADD(bytesScanned, n);
+    k = max(0, min(k, m));  // k >= m already accepts every window; bounds R
+
+    int W = (m + 63) / 64;
+    vector<uint64_t> mask = buildCharMasks(pattern, W);
+    vector<uint64_t> R((k + 1) * W, 0), shifted(W);
+    const int top = W - 1;
+    const uint64_t high = 1ULL << ((m - 1) % 64);
+
+    if (W == 1) {  // common case: keep the k + 1 states in one word each
+        for (int i = 0; i < n; i++) {
+            uint64_t B = mask[(unsigned char)text[i]], prev = 0;
+            for (int d = 0; d <= k; d++) {
+                uint64_t s = (R[d] << 1) | 1;
+                R[d] = (s & B) | prev;
+                prev = s;
+            }
+            if (R[k] & high) {
+                int d = 0;
+                while (!(R[d] & high))
+                    d++;
+                STAT_ADD(matches, 1);
+                onMatch(i - m + 1, d);
+            }
+        }
+        return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        const uint64_t *B = &mask[(unsigned char)text[i] * W];
+        for (int d = 0; d <= k; d++) {
+            uint64_t *Rd = &R[d * W];
+            uint64_t carry = 1;
+            for (int w = 0; w < W; w++) {
+                uint64_t s = (Rd[w] << 1) | carry;
+                carry = Rd[w] >> 63;
+                uint64_t next = s & B[w];
+                if (d > 0)
+                    next |= shifted[w];  // substitute: old R[d-1] shifted
+                shifted[w] = s;
+                Rd[w] = next;
+            }
+        }
+        // R[d] is a subset of R[d + 1], so R[k] decides whether anything matched
+        if (R[k * W + top] & high) {
+            int d = 0;
+            while (!(R[d * W + top] & high))
+                d++;
+            STAT_ADD(matches, 1);
+            onMatch(i - m + 1, d);
+        }
+    }
+}
+
+void shiftAndSearch(const string &text, const string &pattern, int k) {
+    bool found = false;
+    shiftAndScan(text, pattern, k, [&](int i, int d) {
+        cout << "Pattern found at index " << i << " (" << d << " mismatches) using Shift-And\n";
+        found = true;
+    });
+    if (!found)
+        cout << "Pattern not found using Shift-And\n";
+}
+
+// Myers' bit-vector algorithm (edit distance), in Hyyrö's block form
+// Time: O(n * ceil(m / 64)), Space: O(256 * ceil(m / 64))
+// Pv / Mv hold the +1 / -1 vertical deltas of one DP column; blocks pass
+// their bottom horizontal delta to the next block. score tracks the last
+// row, i.e. the edit distance of the best match ending at position i.
+// onMatch(end, distance) is called for every end with distance <= k.
+template <typename OnMatch>
+void myersScan(string_view text, const string &pattern, int k, OnMatch onMatch) {
+    STAT_PHASE(PHASE_SEARCH);
+    int n = text.size(), m = pattern.size();
+    if (m == 0)
+        return;
+    STAT_ADD(bytesScanned, n);
+    k = max(0, min(k, m));  // score never exceeds m
+
+    int W = (m + 63) / 64;
+    vector<uint64_t> peq = buildCharMasks(pattern, W);
+    vector<uint64_t> Pv(W, ~0ULL), Mv(W, 0);
+    const uint64_t lastHigh = 1ULL << ((m - 1) % 64);
+    int score = m;
+
+    if (W == 1) {  // single block: no horizontal delta coming in
+        uint64_t P = ~0ULL, M = 0;
+        for (int i = 0; i < n; i++) {
+            uint64_t Eq = peq[(unsigned char)text[i]];
+            uint64_t Xv = Eq | M;
+            uint64_t Xh = (((Eq & P) + P) ^ P) | Eq;
+            uint64_t Ph = M | ~(Xh | P);
+            uint64_t Mh = P & Xh;
+            if (Ph & lastHigh)
+                score++;
+            else if (Mh & lastHigh)
+                score--;
+            Ph <<= 1;
+            Mh <<= 1;
+            P = Mh | ~(Xv | Ph);
+            M = Ph & Xv;
+            if (score <= k) {
+                STAT_ADD(matches, 1);
+                onMatch(i, score);
+            }
+        }
+        return;
+    }
+
+    for (int i = 0; i < n; i++) {
+        const uint64_t *Eq0 = &peq[(unsigned char)text[i] * W];
+        int hin = 0;  // row 0 is all zeros when searching
+        for (int w = 0; w < W; w++) {
+            uint64_t high = (w == W - 1) ? lastHigh : (1ULL << 63);
+            uint64_t Eq = Eq0[w], P = Pv[w], M = Mv[w];
+            uint64_t Xv = Eq | M;
+            if (hin < 0)
+                Eq |= 1;
+            uint64_t Xh = (((Eq & P) + P) ^ P) | Eq;
+            uint64_t Ph = M | ~(Xh | P);
+            uint64_t Mh = P & Xh;
+            int hout = (Ph & high) ? 1 : (Mh & high) ? -1 : 0;
+            Ph <<= 1;
+            Mh <<= 1;
+            if (hin < 0)
+                Mh |= 1;
+            else if (hin > 0)
+                Ph |= 1;
+            Pv[w] = Mh | ~(Xv | Ph);
+            Mv[w] = Ph & Xv;
+            hin = hout;
+        }
+        score += hin;
+        if (score <= k) {
+            STAT_ADD(matches, 1);
+            onMatch(i, score);
+        }
+    }
+}
+
+void myersSearch(const string &text, const string &pattern, int k) {
+    bool found = false;
+    myersScan(text, pattern, k, [&](int e, int d) {
+        cout << "Pattern found ending at index " << e << " (edit distance " << d << ") using Myers\n";
+        found = true;
+    });
+    if (!found)
+        cout << "Pattern not found using Myers\n";
+}
+
 // ---------------------------------------------------------
 // Check if text is periodic (for adaptive switching)
 // ---------------------------------------------------------
@@ -132,14 +360,22 @@ bool isPeriodic(const string& text) {
 // ---------------------------------------------------------
 // Adaptive Strategy Controller
 // ---------------------------------------------------------
-void adaptiveStringMatch(const string &text, const vector<string> &patterns) {
+// k > 0 switches to approximate matching: up to k substitutions
+// (Shift-And), or up to k insertions / deletions / substitutions when
+// editDistance is set (Myers).
+void adaptiveStringMatch(const string &text, const vector<string> &patterns,
+                         int k = 0, bool editDistance = false) {
     for (auto &pattern : patterns) {
         if (pattern.empty()) {
             cout << "Invalid pattern (empty string)\n";
             continue;
         }
 
-        if (pattern.size() < 5) {
+        if (k > 0 && editDistance) {
+            myersSearch(text, pattern, k);
+        } else if (k > 0) {
+            shiftAndSearch(text, pattern, k);
+        } else if (pattern.size() < 5) {
             naiveSearch(text, pattern);
         } else if (isPeriodic(text)) {
             KMPsearch(text, pattern);
@@ -155,8 +391,23 @@ void adaptiveStringMatch(const string &text, const vector<string> &patterns) {
 // ---------------------------------------------------------
 // MAIN FUNCTION
 // ---------------------------------------------------------
-int main() {
+// Define STRMATCH_NO_MAIN to include this file from another driver
+// (e.g. Bench_23I-0782.cpp) without pulling in the interactive main.
+// Pass --stats to print engine counters after the matches,
+// -k N to allow up to N mismatches, and --edit to count N as edit distance.
+#ifndef STRMATCH_NO_MAIN
+int main(int argc, char **argv) {
     cin.tie(nullptr);
+    bool showStats = false, editDistance = false;
+    int k = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--stats") == 0)
+            showStats = true;
+        else if (strcmp(argv[i], "--edit") == 0)
+            editDistance = true;
+        else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc)
+            k = (int)max(0L, min<long>(strtol(argv[++i], nullptr, 10), INT_MAX));
+    }
 
     cout << "Enter text: ";
     string text;
@@ -174,7 +425,10 @@ int main() {
     }
 
     cout << "\n--- Adaptive String Matching ---\n";
-    adaptiveStringMatch(text, patterns);
+    adaptiveStringMatch(text, patterns, k, editDistance);
 
+    if (showStats)
+        printStats(cout, g_stats);
     return 0;
 }
+#endif
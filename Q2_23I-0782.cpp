@@ -4,6 +4,8 @@
 #include<vector>
 #include<unordered_map>
 #include<cstdint>
+#include<cstring>
+#include "Stats_23I-0782.h"
 
 using namespace std;
 
@@ -72,11 +74,14 @@ string bruteLCS(const string &A, int aL, int aR, const string &B, int bL, int bR
     int la = aR - aL + 1;
     int lb = bR - bL + 1;
     if (la <= 0 || lb <= 0) return "";
+    STAT_PHASE(PHASE_LCS_BRUTE);
+    STAT_ADD(lcsBaseCases, 1);
     string best = "";
     for (int i = aL; i <= aR; ++i) {
         for (int j = bL; j <= bR; ++j) {
             int k = 0;
             while (i + k <= aR && j + k <= bR && A[i + k] == B[j + k]) ++k;
+            STAT_ADD(charComparisons, k + 1);
             if (k > (int)best.size()) best = A.substr(i, k);
         }
     }
@@ -119,6 +124,7 @@ string crossCheckA(const string &A, int aL, int aR, int midA,
         if (!(s <= midA && e >= midA + 1)) continue;
         auto hA = hashA.getHash(s, e);
         uint64_t key = packHash(hA);
+        STAT_ADD(lcsHashProbes, 1);
         auto it = mp.find(key);
         if (it == mp.end()) continue;
         for (int posB : it->second) {
@@ -126,6 +132,7 @@ string crossCheckA(const string &A, int aL, int aR, int midA,
             for (int k = 0; k < L; ++k) {
                 if (A[s + k] != B[posB + k]) { ok = false; break; }
             }
+            if (!ok) STAT_ADD(lcsHashCollisions, 1);
             if (ok) return A.substr(s, L);
         }
     }
@@ -157,6 +164,7 @@ string crossCheckB(const string &A, int aL, int aR,
         if (!(s <= midB && e >= midB + 1)) continue;
         auto hB = hashB.getHash(s, e);
         uint64_t key = packHash(hB);
+        STAT_ADD(lcsHashProbes, 1);
         auto it = mp.find(key);
         if (it == mp.end()) continue;
         for (int posA : it->second) {
@@ -164,6 +172,7 @@ string crossCheckB(const string &A, int aL, int aR,
             for (int k = 0; k < L; ++k) {
                 if (A[posA + k] != B[s + k]) { ok = false; break; }
             }
+            if (!ok) STAT_ADD(lcsHashCollisions, 1);
             if (ok) return B.substr(s, L);
         }
     }
@@ -250,6 +259,7 @@ string crossCheckBothMidpoints(const string &A, int aL, int aR, int midA,
 
                 auto hash1 = hashA.getHash(relA_l, relA_r);
                 auto hash2 = hashB.getHash(relB_l, relB_r);
+                STAT_ADD(lcsHashProbes, 1);
 
                 if (hash1 == hash2) {
                     bool match = true;
@@ -260,6 +270,7 @@ string crossCheckBothMidpoints(const string &A, int aL, int aR, int midA,
                         len = mid_len;
                         lo = mid_len + 1;
                     } else {
+                        STAT_ADD(lcsHashCollisions, 1);
                         hi = mid_len - 1;
                     }
                 } else {
@@ -287,6 +298,8 @@ string lcs_divide_conquer(const string &A, int aL, int aR,
     int la = aR - aL + 1;
     int lb = bR - bL + 1;
     if (la <= 0 || lb <= 0) return "";
+    STAT_ADD(lcsCalls, 1);
+    STAT_MAX(lcsMaxDepth, depth);
 
     const int BRUTE_THRESHOLD = 120;
     if (la <= BRUTE_THRESHOLD || lb <= BRUTE_THRESHOLD) {
@@ -297,18 +310,22 @@ string lcs_divide_conquer(const string &A, int aL, int aR,
     string subA = A.substr(aL, la);
     string subB = B.substr(bL, lb);
     RollingHash absHashA, absHashB;
-    absHashA.build(subA);
-    absHashB.build(subB);
+    {
+        STAT_PHASE(PHASE_LCS_HASH);
+        absHashA.build(subA);
+        absHashB.build(subB);
+    }
 
     int midA = (aL + aR) >> 1;
     int midB = (bL + bR) >> 1;
 
-    string left = lcs_divide_conquer(A, aL, midA, B, bL, midB);
-    string right = lcs_divide_conquer(A, midA + 1, aR, B, midB + 1, bR);
+    string left = lcs_divide_conquer(A, aL, midA, B, bL, midB, depth + 1);
+    string right = lcs_divide_conquer(A, midA + 1, aR, B, midB + 1, bR, depth + 1);
 
     int midA_rel = midA - aL;
     int midB_rel = midB - bL;
 
+    STAT_PHASE(PHASE_LCS_CROSS);
     string crossA = maxCrossA(subA, 0, la - 1, midA_rel, subB, 0, lb - 1, absHashA, absHashB);
     string crossB = maxCrossB(subA, 0, la - 1, subB, 0, lb - 1, midB_rel, absHashA, absHashB);
     string crossBoth = crossCheckBothMidpoints(A, aL, aR, midA, B, bL, bR, midB, absHashA, absHashB);
@@ -353,8 +370,15 @@ string longestCommonSubstring(const string &A, const string &B) {
 
 // -----------------------------
 // Main (file reading) - unchanged
+// Define STRMATCH_NO_MAIN to include this file from another driver.
+// Pass --stats to print recursion / hashing counters after the result.
 // -----------------------------
-int main() {
+#ifndef STRMATCH_NO_MAIN
+int main(int argc, char **argv) {
+    bool showStats = false;
+    for (int i = 1; i < argc; ++i)
+        if (strcmp(argv[i], "--stats") == 0) showStats = true;
+
     string fileA, fileB;
 
     cout << "Enter first file name (with extension): ";
@@ -387,5 +411,7 @@ int main() {
         cout <<'\''<< lcs<<'\'' << "\n";
     }
 
+    if (showStats) printStats(cout, g_stats);
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -1,4 +1,5 @@
 #include <bits/stdc++.h>
+#include "Stats_23I-0782.h"
 using namespace std;
 
 /*
@@ -48,6 +49,7 @@ struct Aho {
         // We'll insert paths for all expansions of '?' characters.
         // To avoid exponential blowup, implement iterative expansion using a vector of current nodes.
 
+        STAT_PHASE(PHASE_TRIE_BUILD);
         vector<int> cur_nodes = {0}; // start at root
         for (char cc : pat) {
             char c = norm_char(cc);
@@ -63,6 +65,7 @@ struct Aho {
                             nxt = trie.size();
                             trie[node].next[id] = nxt;
                             trie.emplace_back();
+                            STAT_ADD(ahoWildcardNodes, 1);
                         }
                         next_nodes.push_back(nxt);
                     }
@@ -100,6 +103,7 @@ struct Aho {
     }
 
     void build_links() {
+        STAT_PHASE(PHASE_LINK_BUILD);
         queue<int> q;
         trie[0].link = 0;
         // init root's children: link = 0
@@ -123,17 +127,30 @@ struct Aho {
                     // aggregate output
                     for (int pid : trie[trie[u].link].out)
                         trie[u].out.push_back(pid);
+                    STAT_ADD(ahoOutputLinks, trie[trie[u].link].out.size());
                     q.push(u);
                 } else {
                     trie[v].next[c] = trie[trie[v].link].next[c];
                 }
             }
         }
+        STAT_SET(ahoStates, trie.size());
+        STAT_SET(ahoBytes, memory_bytes());
     }
 
-    // search returns vector of (position_start, pattern_id)
-    vector<pair<int,int>> search_all(const string &text) {
-        vector<pair<int,int>> res;
+    // approximate heap footprint: node structs, transition tables, output lists
+    size_t memory_bytes() const {
+        size_t bytes = trie.capacity() * sizeof(Node);
+        for (const Node &nd : trie)
+            bytes += nd.next.capacity() * sizeof(int) + nd.out.capacity() * sizeof(int);
+        return bytes;
+    }
+
+    // scan calls onMatch(end_index, pattern_id) for every match, in text order
+    template <typename OnMatch>
+    void scan(string_view text, OnMatch onMatch) const {
+        STAT_PHASE(PHASE_SEARCH);
+        STAT_ADD(bytesScanned, text.size());
         int v = 0;
         for (int i = 0; i < (int)text.size(); ++i) {
             char c = norm_char(text[i]);
@@ -144,21 +161,33 @@ struct Aho {
                 continue;
             }
             v = trie[v].next[cid];
-            if (!trie[v].out.empty()) {
-                for (int pid : trie[v].out) {
-                    // pattern length unknown here — to report start index we need pattern lengths externally
-                    res.emplace_back(i, pid); // store match end index; caller can convert with pattern length
-                }
+            STAT_ADD(matches, trie[v].out.size());
+            for (int pid : trie[v].out) {
+                // pattern length unknown here — to report start index we need pattern lengths externally
+                onMatch(i, pid);
             }
         }
+    }
+
+    // search returns vector of (position_end, pattern_id)
+    vector<pair<int,int>> search_all(const string &text) const {
+        vector<pair<int,int>> res;
+        // store match end index; caller can convert with pattern length
+        scan(text, [&](int end_idx, int pid) { res.emplace_back(end_idx, pid); });
         return res;
     }
 };
 
 // --------------------------
 // Example usage (main)
+// Define STRMATCH_NO_MAIN to include this file from another driver.
+// Pass --stats to print automaton size / scan counters after the matches.
 // --------------------------
-int main() {
+#ifndef STRMATCH_NO_MAIN
+int main(int argc, char **argv) {
+    bool showStats = false;
+    for (int i = 1; i < argc; ++i)
+        if (strcmp(argv[i], "--stats") == 0) showStats = true;
 
     cout << "Enter number of patterns: ";
     int n;
@@ -216,5 +245,7 @@ int main() {
         cout << "(" << pid << ", " << start << "): '" << matched << "'  pattern='" << patterns[pid] << "'\n";
     }
 
+    if (showStats) printStats(cout, g_stats);
     return 0;
 }
+#endif
@@ -0,0 +1,294 @@
+/*
+Batch front end for the Q1 / Q3 engines and Teddy.
+- Reads patterns from a file (one per line, empty lines ignored).
+- Scans every file given on the command line; directories are walked recursively.
+- Files are memory-mapped and scanned by a fixed pool of worker threads, so
+  the automaton is built once per run instead of once per file.
+
+Build:
+    g++ -O2 -std=c++17 -pthread Scan_23I-0782.cpp -o output/Scan_23I-0782
+
+Usage:
+    Scan_23I-0782 -p patterns.txt [-e auto|naive|kmp|rabin-karp|aho|teddy] [-j threads] [--stats] path...
+
+Engines:
+    naive / kmp / rabin-karp  exact, case-sensitive; one pass per pattern
+    aho                       one pass for all patterns; case-insensitive, '?' matches any char;
+                              printable ASCII (32..126) patterns only
+    teddy                     same results as aho for up to 64 printable literals without '?',
+                              using the SIMD prefilter in Teddy_23I-0782.h
+    auto (default)            teddy for a selective set (at most 16 literals, none shorter
+                              than 3, prefixes rare in the first 64K of the first non-empty
+                              file; see Teddy::selective), else aho.
+                              This holds for any number of patterns, so adding a pattern never
+                              changes how the others match. Pick naive / kmp / rabin-karp
+                              for exact-case matching, or for patterns with bytes outside
+                              32..126 (tabs, UTF-8), which aho / teddy / auto reject.
+
+Output, one line per match (tab-separated, start index is 0-based):
+    <file>	<start_index>	<pattern_id>	<pattern>
+Lines from different files may interleave; lines themselves never do.
+Exit status: 0 if anything matched, 1 if nothing matched, 2 on any error.
+*/
+
+#include "MappedFile_23I-0782.h"
+
+// the Q files are always included without their mains; SCAN_NO_MAIN
+// remembers whether our own includer asked for the same
+#ifdef STRMATCH_NO_MAIN
+#define SCAN_NO_MAIN
+#endif
+#define STRMATCH_NO_MAIN
+#include "Q1_23I-0782.cpp"
+#include "Q3_23I-0782.cpp"
+#include "Teddy_23I-0782.h"
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+enum Engine { ENGINE_AUTO, ENGINE_NAIVE, ENGINE_KMP, ENGINE_RABIN_KARP, ENGINE_AHO, ENGINE_TEDDY };
+
+static const char *const ENGINE_NAMES[] = {"auto", "naive", "kmp", "rabin-karp", "aho", "teddy"};
+static const int ENGINE_COUNT = 6;
+
+// -----------------------------
+// Shared, read-only scan setup
+// -----------------------------
+struct ScanSetup {
+    vector<string> patterns;
+    vector<string> recordTails;  // "\t<id>\t<pattern>\n", precomputed per pattern
+    Engine engine = ENGINE_AUTO;
+    Aho aho;                     // built once when engine == ENGINE_AHO
+    Teddy teddy;                 // built once when engine == ENGINE_TEDDY
+};
+
+// auto always stays with the case-insensitive set engines, so a single
+// pattern matches exactly as it would alongside others. Teddy is only
+// taken when it is expected to be faster: building it is cheap, and its
+// candidate rate is measured on `sample`, a prefix of the input.
+Engine resolveEngine(const vector<string> &patterns, Engine requested, Teddy &teddy, string_view sample) {
+    if (requested != ENGINE_AUTO) return requested;
+    if (!teddy.build(patterns)) return ENGINE_AHO;
+    teddy.calibrate(sample);
+    return teddy.selective() ? ENGINE_TEDDY : ENGINE_AHO;
+}
+
+// Serialises writes so each flushed block of lines reaches stdout intact
+struct OutputSink {
+    mutex m;
+    void write(const string &buf) {
+        if (buf.empty()) return;
+        lock_guard<mutex> lock(m);
+        fwrite(buf.data(), 1, buf.size(), stdout);
+    }
+};
+
+// Resolves the engine and builds its automaton or masks. Returns false (with
+// a message in err) when the patterns cannot be matched by that engine.
+bool prepareScan(ScanSetup &setup, Engine requested, string_view sample, string &err) {
+    setup.engine = resolveEngine(setup.patterns, requested, setup.teddy, sample);
+    if (setup.engine != ENGINE_AHO && setup.engine != ENGINE_TEDDY) return true;
+    // Aho's alphabet is printable ASCII: other bytes would be dropped from the
+    // pattern and reset the scan, giving wrong start indices
+    for (int i = 0; i < (int)setup.patterns.size(); ++i)
+        for (char c : setup.patterns[i])
+            if (ch_id(c) == -1) {
+                err = "pattern " + to_string(i) + " has bytes outside printable ASCII; " +
+                      ENGINE_NAMES[requested] + " cannot match it, use -e naive|kmp|rabin-karp";
+                return false;
+            }
+    if (requested == ENGINE_TEDDY && !setup.teddy.build(setup.patterns)) {
+        cerr << "Note: teddy takes at most " << Teddy::MAX_PATTERNS
+             << " printable literals without '?'; using aho\n";
+        setup.engine = ENGINE_AHO;
+    }
+    if (setup.engine == ENGINE_AHO) {
+        for (int i = 0; i < (int)setup.patterns.size(); ++i) {
+            string p = setup.patterns[i];
+            for (char &ch : p) ch = norm_char(ch);
+            setup.aho.insert_pattern(p, i);
+        }
+        setup.aho.build_links();
+    }
+    return true;
+}
+
+// -----------------------------
+// Per-file scan
+// -----------------------------
+// Appends match records to a local buffer, handing it to the sink every
+// 64K so a file with millions of matches does not grow without bound.
+// Returns false (with a message in err) when the file cannot be scanned.
+bool scanFile(const ScanSetup &setup, const string &path, OutputSink &sink,
+              long long &matches, string &err) {
+    MappedFile file;
+    if (!file.open(path)) { err = file.error; return false; }
+    if (file.size > (size_t)INT_MAX) { err = "file too large (engines use int indices)"; return false; }
+    string_view text = file.view();
+
+    string buf;
+    auto emit = [&](int start, int pid) {
+        buf += path;
+        buf += '\t';
+        buf += to_string(start);
+        buf += setup.recordTails[pid];
+        ++matches;
+        if (buf.size() >= (1 << 16)) { sink.write(buf); buf.clear(); }
+    };
+
+    if (setup.engine == ENGINE_AHO) {
+        setup.aho.scan(text, [&](int end_idx, int pid) {
+            int start = end_idx - (int)setup.patterns[pid].size() + 1;
+            if (start >= 0) emit(start, pid);
+        });
+    } else if (setup.engine == ENGINE_TEDDY) {
+        setup.teddy.scan(text, [&](int end_idx, int pid) {
+            emit(end_idx - (int)setup.patterns[pid].size() + 1, pid);
+        });
+    } else {
+        for (int pid = 0; pid < (int)setup.patterns.size(); ++pid) {
+            const string &pat = setup.patterns[pid];
+            auto onMatch = [&](int start) { emit(start, pid); };
+            if (setup.engine == ENGINE_NAIVE) naiveScan(text, pat, onMatch);
+            else if (setup.engine == ENGINE_KMP) KMPscan(text, pat, onMatch);
+            else rabinKarpScan(text, pat, onMatch);
+        }
+    }
+    sink.write(buf);
+    return true;
+}
+
+// -----------------------------
+// Input collection
+// -----------------------------
+bool readPatterns(const string &path, vector<string> &patterns) {
+    ifstream in(path, ios::binary);
+    if (!in.is_open()) return false;
+    string line;
+    while (getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) patterns.push_back(line);
+    }
+    return true;
+}
+
+// Expands directories recursively; returns false if any argument was unusable
+bool collectFiles(const vector<string> &args, vector<string> &files) {
+    bool ok = true;
+    for (const string &arg : args) {
+        error_code ec;
+        if (fs::is_directory(arg, ec)) {
+            auto opts = fs::directory_options::skip_permission_denied;
+            for (fs::recursive_directory_iterator it(arg, opts, ec), end; !ec && it != end; it.increment(ec))
+                if (it->is_regular_file(ec)) files.push_back(it->path().string());
+            if (ec) { cerr << "Error: cannot walk '" << arg << "': " << ec.message() << "\n"; ok = false; }
+        } else if (fs::is_regular_file(arg, ec)) {
+            files.push_back(arg);
+        } else {
+            cerr << "Error: Could not open file '" << arg << "'\n";
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// -----------------------------
+// Main
+// Define STRMATCH_NO_MAIN to include this file from another driver.
+// -----------------------------
+#ifndef SCAN_NO_MAIN
+static void usage() {
+    cerr << "Usage: Scan_23I-0782 -p patterns.txt [-e auto|naive|kmp|rabin-karp|aho|teddy]"
+            " [-j threads] [--stats] path...\n";
+}
+
+int main(int argc, char **argv) {
+    string patternFile;
+    Engine requested = ENGINE_AUTO;
+    unsigned jobs = max(1u, thread::hardware_concurrency());
+    bool showStats = false;
+    vector<string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        if (a == "--stats") showStats = true;
+        else if ((a == "-p" || a == "-e" || a == "-j") && i + 1 >= argc) { usage(); return 2; }
+        else if (a == "-p") patternFile = argv[++i];
+        else if (a == "-j") jobs = (unsigned)max(1, atoi(argv[++i]));
+        else if (a == "-e") {
+            string e = argv[++i];
+            int found = -1;
+            for (int k = 0; k < ENGINE_COUNT; ++k)
+                if (e == ENGINE_NAMES[k]) found = k;
+            if (found < 0) { cerr << "Unknown engine '" << e << "'\n"; usage(); return 2; }
+            requested = (Engine)found;
+        }
+        else paths.push_back(a);
+    }
+    if (patternFile.empty() || paths.empty()) { usage(); return 2; }
+
+    ScanSetup setup;
+    if (!readPatterns(patternFile, setup.patterns)) {
+        cerr << "Error: Could not open file '" << patternFile << "'\n";
+        return 2;
+    }
+    if (setup.patterns.empty()) { cerr << "Error: no patterns in '" << patternFile << "'\n"; return 2; }
+    for (int i = 0; i < (int)setup.patterns.size(); ++i)
+        setup.recordTails.push_back("\t" + to_string(i) + "\t" + setup.patterns[i] + "\n");
+
+    vector<string> files;
+    bool ok = collectFiles(paths, files);
+
+    // auto measures Teddy's candidate rate on the start of the first non-empty file
+    MappedFile sampleFile;
+    string_view sample;
+    for (const string &f : files)
+        if (sampleFile.open(f) && sampleFile.size > 0) {
+            sample = sampleFile.view().substr(0, 1 << 16);
+            break;
+        }
+    string err;
+    if (!prepareScan(setup, requested, sample, err)) { cerr << "Error: " << err << "\n"; return 2; }
+
+    OutputSink sink;
+    mutex statsMutex;
+    MatchStats total = g_stats;  // automaton build counters from this thread
+    atomic<size_t> next(0);
+    atomic<long long> totalMatches(0);
+    atomic<bool> failed(false);
+
+    auto worker = [&]() {
+        long long matches = 0;
+        size_t i;
+        while ((i = next++) < files.size()) {
+            string err;
+            if (!scanFile(setup, files[i], sink, matches, err)) {
+                lock_guard<mutex> lock(sink.m);
+                cerr << "Error: '" << files[i] << "': " << err << "\n";
+                failed = true;
+            }
+        }
+        totalMatches += matches;
+        lock_guard<mutex> lock(statsMutex);
+        mergeStats(total, g_stats);
+    };
+
+    unsigned n = (unsigned)min<size_t>(jobs, max<size_t>(1, files.size()));
+    vector<thread> pool;
+    for (unsigned t = 0; t < n; ++t) pool.emplace_back(worker);
+    for (auto &t : pool) t.join();
+    fflush(stdout);
+
+    if (showStats) {
+        cerr << "\nengine: " << ENGINE_NAMES[setup.engine] << ", files: " << files.size()
+             << ", threads: " << n << ", matches: " << totalMatches << "\n";
+        printStats(cerr, total);
+    }
+    if (!ok || failed) return 2;
+    return totalMatches > 0 ? 0 : 1;
+}
+#endif
@@ -0,0 +1,169 @@
+#ifndef STATS_23I_0782_H
+#define STATS_23I_0782_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+/*
+Hot-path instrumentation shared by Q1 / Q2 / Q3 and Teddy.
+- Counters live in a thread_local MatchStats (g_stats), so worker threads
+  never contend; callers merge per-thread copies with mergeStats().
+- Compile with -DSTRMATCH_STATS to enable. Without it every STAT_* macro
+  expands to nothing and the engines run exactly as before.
+*/
+
+enum StatPhase {
+    PHASE_PREPROCESS,   // KMP LPS table, Rabin-Karp initial hashes, Teddy masks
+    PHASE_SEARCH,       // Q1 scans, Aho::scan and Teddy::scan
+    PHASE_TRIE_BUILD,   // Aho::insert_pattern
+    PHASE_LINK_BUILD,   // Aho::build_links
+    PHASE_LCS_HASH,     // RollingHash::build on both slices
+    PHASE_LCS_CROSS,    // midpoint-crossing checks
+    PHASE_LCS_BRUTE,    // bruteLCS base cases
+    PHASE_COUNT
+};
+
+static const char *const STAT_PHASE_NAMES[PHASE_COUNT] = {
+    "preprocess", "search", "trie_build", "link_build", "lcs_hash", "lcs_cross", "lcs_brute"};
+
+struct MatchStats {
+    // Q1 engines
+    uint64_t bytesScanned = 0;
+    uint64_t charComparisons = 0;
+    uint64_t matches = 0;
+    uint64_t kmpFailureSteps = 0;     // j = lps[j - 1] fallbacks
+    uint64_t rkHashHits = 0;          // window hash == pattern hash
+    uint64_t rkFalsePositives = 0;    // ... that failed verification
+
+    // Aho (Q3)
+    uint64_t ahoStates = 0;
+    uint64_t ahoBytes = 0;            // trie tables + output lists
+    uint64_t ahoWildcardNodes = 0;    // states created while expanding '?'
+    uint64_t ahoOutputLinks = 0;      // pattern ids copied along failure links
+
+    // Teddy
+    uint64_t teddyCandidates = 0;     // positions flagged by the nibble masks
+    uint64_t teddyFalsePositives = 0; // bucket patterns that failed verification
+
+    // LCS (Q2)
+    uint64_t lcsCalls = 0;
+    uint64_t lcsMaxDepth = 0;
+    uint64_t lcsBaseCases = 0;        // bruteLCS calls
+    uint64_t lcsHashProbes = 0;       // hash lookups / comparisons
+    uint64_t lcsHashCollisions = 0;   // equal hashes, different text
+
+    uint64_t phaseNs[PHASE_COUNT] = {};
+};
+
+inline thread_local MatchStats g_stats;
+
+inline void resetStats() { g_stats = MatchStats(); }
+
+inline void mergeStats(MatchStats &into, const MatchStats &s) {
+    into.bytesScanned += s.bytesScanned;
+    into.charComparisons += s.charComparisons;
+    into.matches += s.matches;
+    into.kmpFailureSteps += s.kmpFailureSteps;
+    into.rkHashHits += s.rkHashHits;
+    into.rkFalsePositives += s.rkFalsePositives;
+    // automaton is shared, so size is a maximum rather than a sum
+    if (s.ahoStates > into.ahoStates) into.ahoStates = s.ahoStates;
+    if (s.ahoBytes > into.ahoBytes) into.ahoBytes = s.ahoBytes;
+    into.ahoWildcardNodes += s.ahoWildcardNodes;
+    into.ahoOutputLinks += s.ahoOutputLinks;
+    into.teddyCandidates += s.teddyCandidates;
+    into.teddyFalsePositives += s.teddyFalsePositives;
+    into.lcsCalls += s.lcsCalls;
+    if (s.lcsMaxDepth > into.lcsMaxDepth) into.lcsMaxDepth = s.lcsMaxDepth;
+    into.lcsBaseCases += s.lcsBaseCases;
+    into.lcsHashProbes += s.lcsHashProbes;
+    into.lcsHashCollisions += s.lcsHashCollisions;
+    for (int p = 0; p < PHASE_COUNT; ++p) into.phaseNs[p] += s.phaseNs[p];
+}
+
+// Adds the lifetime of the object to g_stats.phaseNs[phase]
+struct StatPhaseTimer {
+    StatPhase phase;
+    std::chrono::steady_clock::time_point t0;
+    explicit StatPhaseTimer(StatPhase p) : phase(p), t0(std::chrono::steady_clock::now()) {}
+    ~StatPhaseTimer() {
+        g_stats.phaseNs[phase] += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+    }
+};
+
+#ifdef STRMATCH_STATS
+#define STATS_ENABLED 1
+#define STAT_ADD(field, n) (g_stats.field += (uint64_t)(n))
+#define STAT_SET(field, v) (g_stats.field = (uint64_t)(v))
+#define STAT_MAX(field, v) \
+    do { if ((uint64_t)(v) > g_stats.field) g_stats.field = (uint64_t)(v); } while (0)
+#define STAT_CAT2(a, b) a##b
+#define STAT_CAT(a, b) STAT_CAT2(a, b)
+#define STAT_PHASE(p) StatPhaseTimer STAT_CAT(statPhase_, __LINE__)(p)
+#else
+#define STATS_ENABLED 0
+#define STAT_ADD(field, n) ((void)0)
+#define STAT_SET(field, v) ((void)0)
+#define STAT_MAX(field, v) ((void)0)
+#define STAT_PHASE(p) ((void)0)
+#endif
+
+// Human-readable --stats report; zero counters are skipped
+inline void printStats(std::ostream &os, const MatchStats &s) {
+    os << "\n--- Stats ---\n";
+    if (!STATS_ENABLED) {
+        os << "Counters are compiled out; rebuild with -DSTRMATCH_STATS\n";
+        return;
+    }
+    auto row = [&](const char *name, uint64_t v) {
+        if (v) os << "  " << name << ": " << v << "\n";
+    };
+    row("bytes scanned", s.bytesScanned);
+    row("char comparisons", s.charComparisons);
+    row("matches", s.matches);
+    row("KMP failure-link steps", s.kmpFailureSteps);
+    row("Rabin-Karp hash hits", s.rkHashHits);
+    row("Rabin-Karp false positives", s.rkFalsePositives);
+    row("Aho states", s.ahoStates);
+    row("Aho memory (bytes)", s.ahoBytes);
+    row("Aho states from '?' expansion", s.ahoWildcardNodes);
+    row("Aho output links", s.ahoOutputLinks);
+    row("Teddy candidates", s.teddyCandidates);
+    row("Teddy false positives", s.teddyFalsePositives);
+    row("LCS recursive calls", s.lcsCalls);
+    row("LCS max recursion depth", s.lcsMaxDepth);
+    row("LCS base cases (bruteLCS)", s.lcsBaseCases);
+    row("LCS hash probes", s.lcsHashProbes);
+    row("LCS hash collisions", s.lcsHashCollisions);
+    for (int p = 0; p < PHASE_COUNT; ++p)
+        if (s.phaseNs[p])
+            os << "  time " << STAT_PHASE_NAMES[p] << ": " << s.phaseNs[p] / 1e6 << " ms\n";
+}
+
+// Same counters as a single JSON object (all fields, for diffing runs)
+inline void printStatsJSON(std::ostream &os, const MatchStats &s) {
+    os << "{\"bytes_scanned\": " << s.bytesScanned
+       << ", \"char_comparisons\": " << s.charComparisons
+       << ", \"matches\": " << s.matches
+       << ", \"kmp_failure_steps\": " << s.kmpFailureSteps
+       << ", \"rk_hash_hits\": " << s.rkHashHits
+       << ", \"rk_false_positives\": " << s.rkFalsePositives
+       << ", \"aho_states\": " << s.ahoStates
+       << ", \"aho_bytes\": " << s.ahoBytes
+       << ", \"aho_wildcard_nodes\": " << s.ahoWildcardNodes
+       << ", \"aho_output_links\": " << s.ahoOutputLinks
+       << ", \"teddy_candidates\": " << s.teddyCandidates
+       << ", \"teddy_false_positives\": " << s.teddyFalsePositives
+       << ", \"lcs_calls\": " << s.lcsCalls
+       << ", \"lcs_max_depth\": " << s.lcsMaxDepth
+       << ", \"lcs_base_cases\": " << s.lcsBaseCases
+       << ", \"lcs_hash_probes\": " << s.lcsHashProbes
+       << ", \"lcs_hash_collisions\": " << s.lcsHashCollisions;
+    for (int p = 0; p < PHASE_COUNT; ++p)
+        os << ", \"" << STAT_PHASE_NAMES[p] << "_ns\": " << s.phaseNs[p];
+    os << "}";
+}
+
+#endif
@@ -0,0 +1,311 @@
+#ifndef TEDDY_23I_0782_H
+#define TEDDY_23I_0782_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Stats_23I-0782.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TEDDY_X86 1
+#include <immintrin.h>
+#endif
+
+/*
+Teddy-style multi-literal prefilter (after Hyperscan's Teddy) for up to 64
+literals, with the same matching rules as Aho in Q3: ASCII letters
+match case-insensitively, and only printable literals without '?' are
+accepted.
+- Patterns are spread over 8 buckets; every bucket is one bit.
+- For each of the first 4 pattern bytes there are two 16-entry tables,
+  indexed by the low and high nibble of a text byte. A table entry holds
+  the buckets whose pattern can have that nibble at that offset.
+- PSHUFB looks up 16 (SSSE3) or 32 (AVX2) text bytes per instruction. ANDing
+  the eight lookups leaves, per position, the buckets whose 4-byte prefix
+  may start there; only those patterns are compared in full. (Hyperscan
+  stops at 3; the 4th byte cuts candidates ~4x on small alphabets.)
+Kernels are compiled with target attributes and picked at runtime, so a
+plain -O2 build still uses AVX2 where the CPU has it.
+Teddy only wins when candidates are rare; calibrate() measures that on a
+sample of the input and selective() tells callers when to prefer Aho.
+*/
+
+struct Teddy {
+    static constexpr int MAX_PATTERNS = 64;
+    static constexpr int BUCKETS = 8;
+    static constexpr int WIDTH = 4;                // prefix bytes covered by the masks
+    static constexpr int AUTO_MAX_PATTERNS = 16;   // see selective()
+    static constexpr double MAX_CANDIDATE_RATE = 0.05;
+
+    std::vector<std::string> patterns;   // lowercased
+    std::vector<int> bucketIds[BUCKETS];
+    int width = 0;                       // min(WIDTH, shortest pattern)
+    alignas(16) uint8_t lo[WIDTH][16];
+    alignas(16) uint8_t hi[WIDTH][16];
+    uint8_t byteMask[WIDTH][256];        // lo & hi per byte, for the scalar path
+    uint8_t lower[256];
+    double candidateRate = 1.0;          // estimated verify() calls per text byte
+
+    // Patterns Teddy can take over from Aho without changing results
+    static bool eligible(const std::vector<std::string> &pats) {
+        if (pats.empty() || (int)pats.size() > MAX_PATTERNS) return false;
+        for (const std::string &p : pats) {
+            if (p.empty()) return false;
+            for (char c : p)
+                if (c < 32 || c > 126 || c == '?') return false;
+        }
+        return true;
+    }
+
+    // Returns false (and stays unusable) when the set is not eligible
+    bool build(const std::vector<std::string> &pats) {
+        if (!eligible(pats)) return false;
+        STAT_PHASE(PHASE_PREPROCESS);
+        for (int c = 0; c < 256; ++c)
+            lower[c] = (c >= 'A' && c <= 'Z') ? (uint8_t)(c - 'A' + 'a') : (uint8_t)c;
+        patterns.clear();
+        for (const std::string &p : pats) {
+            std::string q = p;
+            for (char &ch : q) ch = (char)lower[(uint8_t)ch];
+            patterns.push_back(q);
+        }
+
+        width = WIDTH;
+        for (const std::string &p : patterns) width = std::min(width, (int)p.size());
+
+        // neighbours in sorted order share prefixes, so contiguous runs make
+        // buckets whose masks stay narrow
+        std::vector<int> order(patterns.size());
+        for (int i = 0; i < (int)order.size(); ++i) order[i] = i;
+        std::sort(order.begin(), order.end(),
+                  [&](int a, int b) { return patterns[a] < patterns[b]; });
+        int used = std::min<int>(BUCKETS, (int)order.size());
+        for (int b = 0; b < BUCKETS; ++b) bucketIds[b].clear();
+        for (int i = 0; i < (int)order.size(); ++i)
+            bucketIds[(long long)i * used / (int)order.size()].push_back(order[i]);
+
+        // offsets past `width` accept everything so the kernels can always AND WIDTH lookups
+        for (int k = 0; k < WIDTH; ++k)
+            for (int x = 0; x < 16; ++x) lo[k][x] = hi[k][x] = (k < width) ? 0 : 0xFF;
+        for (int b = 0; b < BUCKETS; ++b) {
+            for (int pid : bucketIds[b]) {
+                for (int k = 0; k < width; ++k) {
+                    uint8_t c = (uint8_t)patterns[pid][k];
+                    uint8_t variants[2] = {c, c};
+                    if (c >= 'a' && c <= 'z') variants[1] = (uint8_t)(c - 'a' + 'A');
+                    for (uint8_t v : variants) {
+                        lo[k][v & 15] |= (uint8_t)(1 << b);
+                        hi[k][v >> 4] |= (uint8_t)(1 << b);
+                    }
+                }
+            }
+        }
+        for (int k = 0; k < WIDTH; ++k)
+            for (int c = 0; c < 256; ++c) byteMask[k][c] = lo[k][c & 15] & hi[k][c >> 4];
+
+        // Expected candidates per position on English-like text until
+        // calibrate() measures the real input: per bucket, the chance that
+        // all `width` lookups hit, summed over buckets.
+        const double *ref = referenceFrequencies();
+        candidateRate = 0;
+        for (int b = 0; b < BUCKETS; ++b) {
+            if (bucketIds[b].empty()) continue;
+            double hit = 1;
+            for (int k = 0; k < width; ++k) {
+                double pk = 0;
+                for (int c = 0; c < 256; ++c)
+                    if (byteMask[k][c] >> b & 1) pk += ref[c];
+                hit *= pk;
+            }
+            candidateRate += hit;
+        }
+        return true;
+    }
+
+    // Replaces the estimate with the candidate rate measured on `sample`
+    // (e.g. the first 64K of the input); a narrow alphabet such as DNA or
+    // periodic text shows up here even when the patterns look selective
+    void calibrate(std::string_view sample) {
+        if (sample.size() < (size_t)width || width == 0) return;
+        const uint8_t *t = (const uint8_t *)sample.data();
+        size_t positions = sample.size() - width + 1, hits = 0;
+        for (size_t i = 0; i < positions; ++i) {
+            unsigned m = 0xFF;
+            for (int k = 0; k < width && m; ++k) m &= byteMask[k][t[i + k]];
+            hits += m != 0;
+        }
+        candidateRate = (double)hits / positions;
+    }
+
+    // Byte distribution of English prose (letter frequencies folded over
+    // case, ~18% spaces, the rest spread over digits and punctuation)
+    static const double *referenceFrequencies() {
+        static const struct Table {
+            double freq[256] = {};
+            Table() {
+                static const double LETTERS[26] = {8.2, 1.5, 2.8, 4.3, 12.7, 2.2, 2.0, 6.1, 7.0, 0.15, 0.77, 4.0, 2.4,
+                                                   6.7, 7.5, 1.9, 0.1, 6.0, 6.3, 9.1, 2.8, 1.0, 2.4, 0.15, 2.0, 0.07};
+                double letters = 0;
+                for (double f : LETTERS) letters += f;
+                for (int c = 33; c <= 126; ++c) freq[c] = 0.04 / 68;  // 68 non-letter printables
+                for (int i = 0; i < 26; ++i) freq['a' + i] = 0.78 * LETTERS[i] / letters, freq['A' + i] = 0;
+                freq[' '] = 0.18;
+            }
+        } table;
+        return table.freq;
+    }
+
+    // Whether a built Teddy is expected to beat Aho (~110-190 MB/s). Measured
+    // candidate rates: 1-2 keywords sit at 0-0.02 and run at 1.1-3.3 GB/s,
+    // 8 literals on English near 0.05 still at ~400 MB/s; Teddy falls to
+    // Aho's speed near 0.13 (16 DNA literals) and to 8-120 MB/s on periodic
+    // text or with a 1-2 byte pattern, where almost every position is verified.
+    bool selective() const {
+        return (int)patterns.size() <= AUTO_MAX_PATTERNS && width >= 3 &&
+               candidateRate <= MAX_CANDIDATE_RATE;
+    }
+
+    // Widest kernel this CPU runs: 2 = AVX2, 1 = SSSE3, 0 = scalar only
+    static int cpuLevel() {
+#ifdef TEDDY_X86
+        static const int level = __builtin_cpu_supports("avx2") ? 2
+                               : __builtin_cpu_supports("ssse3") ? 1 : 0;
+        return level;
+#else
+        return 0;
+#endif
+    }
+
+    // scan calls onMatch(end_index, pattern_id), like Aho::scan; matches
+    // are reported in order of their start index
+    template <typename OnMatch>
+    void scan(std::string_view text, OnMatch onMatch) const {
+        scanAt(cpuLevel(), text, onMatch);
+    }
+
+    // scan with the kernel for `level` (capped at cpuLevel()), so every
+    // path can be checked on one machine
+    template <typename OnMatch>
+    void scanAt(int level, std::string_view text, OnMatch onMatch) const {
+        STAT_PHASE(PHASE_SEARCH);
+        STAT_ADD(bytesScanned, text.size());
+        level = std::min(level, cpuLevel());
+        size_t i = 0;
+#ifdef TEDDY_X86
+        if (level == 2) i = scanAVX2(text, onMatch);
+        else if (level == 1) i = scanSSSE3(text, onMatch);
+#endif
+        scanScalar(text, i, onMatch);
+    }
+
+private:
+    // candidate at `start` for the buckets set in `bits`: compare each pattern in full
+    template <typename OnMatch>
+    void verify(std::string_view text, size_t start, unsigned bits, OnMatch &onMatch) const {
+        STAT_ADD(teddyCandidates, 1);
+        const uint8_t *t = (const uint8_t *)text.data();
+        while (bits) {
+            int b = __builtin_ctz(bits);
+            bits &= bits - 1;
+            for (int pid : bucketIds[b]) {
+                const std::string &p = patterns[pid];
+                if (start + p.size() > text.size()) { STAT_ADD(teddyFalsePositives, 1); continue; }
+                size_t k = 0;
+                while (k < p.size() && lower[t[start + k]] == (uint8_t)p[k]) ++k;
+                if (k == p.size()) {
+                    STAT_ADD(matches, 1);
+                    onMatch((int)(start + p.size() - 1), pid);
+                } else {
+                    STAT_ADD(teddyFalsePositives, 1);
+                }
+            }
+        }
+    }
+
+    template <typename OnMatch>
+    void scanScalar(std::string_view text, size_t i, OnMatch &onMatch) const {
+        const uint8_t *t = (const uint8_t *)text.data();
+        size_t n = text.size();
+        for (; i < n; ++i) {
+            unsigned m = 0xFF;
+            for (int k = 0; k < WIDTH && m; ++k) {
+                if (i + k < n) m &= byteMask[k][t[i + k]];
+                else if (k < width) m = 0;
+            }
+            if (m) verify(text, i, m, onMatch);
+        }
+    }
+
+#ifdef TEDDY_X86
+    // Both kernels return the first position they did not examine.
+    template <typename OnMatch>
+    __attribute__((target("ssse3")))
+    size_t scanSSSE3(std::string_view text, OnMatch &onMatch) const {
+        const uint8_t *t = (const uint8_t *)text.data();
+        size_t n = text.size(), i = 0;
+        const __m128i nib = _mm_set1_epi8(0x0F), zero = _mm_setzero_si128();
+        __m128i L[WIDTH], H[WIDTH];
+        for (int k = 0; k < WIDTH; ++k) {
+            L[k] = _mm_load_si128((const __m128i *)lo[k]);
+            H[k] = _mm_load_si128((const __m128i *)hi[k]);
+        }
+        alignas(16) uint8_t res[16];
+        for (; i + 16 + WIDTH - 1 <= n; i += 16) {
+            __m128i acc = _mm_set1_epi8((char)0xFF);
+            for (int k = 0; k < WIDTH; ++k) {
+                __m128i v = _mm_loadu_si128((const __m128i *)(t + i + k));
+                __m128i l = _mm_shuffle_epi8(L[k], _mm_and_si128(v, nib));
+                __m128i h = _mm_shuffle_epi8(H[k], _mm_and_si128(_mm_srli_epi16(v, 4), nib));
+                acc = _mm_and_si128(acc, _mm_and_si128(l, h));
+            }
+            unsigned m = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(acc, zero)) & 0xFFFFu;
+            if (!m) continue;
+            _mm_store_si128((__m128i *)res, acc);
+            while (m) {
+                int j = __builtin_ctz(m);
+                m &= m - 1;
+                verify(text, i + j, res[j], onMatch);
+            }
+        }
+        return i;
+    }
+
+    template <typename OnMatch>
+    __attribute__((target("avx2")))
+    size_t scanAVX2(std::string_view text, OnMatch &onMatch) const {
+        const uint8_t *t = (const uint8_t *)text.data();
+        size_t n = text.size(), i = 0;
+        const __m256i nib = _mm256_set1_epi8(0x0F), zero = _mm256_setzero_si256();
+        __m256i L[WIDTH], H[WIDTH];
+        for (int k = 0; k < WIDTH; ++k) {
+            // PSHUFB works per 128-bit lane, so both lanes get the same table
+            L[k] = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)lo[k]));
+            H[k] = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)hi[k]));
+        }
+        alignas(32) uint8_t res[32];
+        for (; i + 32 + WIDTH - 1 <= n; i += 32) {
+            __m256i acc = _mm256_set1_epi8((char)0xFF);
+            for (int k = 0; k < WIDTH; ++k) {
+                __m256i v = _mm256_loadu_si256((const __m256i *)(t + i + k));
+                __m256i l = _mm256_shuffle_epi8(L[k], _mm256_and_si256(v, nib));
+                __m256i h = _mm256_shuffle_epi8(H[k], _mm256_and_si256(_mm256_srli_epi16(v, 4), nib));
+                acc = _mm256_and_si256(acc, _mm256_and_si256(l, h));
+            }
+            unsigned m = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(acc, zero));
+            if (!m) continue;
+            _mm256_store_si256((__m256i *)res, acc);
+            while (m) {
+                int j = __builtin_ctz(m);
+                m &= m - 1;
+                verify(text, i + j, res[j], onMatch);
+            }
+        }
+        return i;
+    }
+#endif
+};
+
+#endif